@@ -0,0 +1,122 @@
+/******************************************************************************
+ *
+ * Counts the heap allocations per sort of n random strings that are too long for the
+ * small-string optimization. The strings are sorted once as a type that can only be copied
+ * (which is how the sorts handled values before they used moves) and once as std::string.
+ *
+ *      % ./alloc_bench 100000
+ *      n = 100000
+ *      sort                           copy only       moves
+ *      insertion_sort (n/100)            257570           0
+ *      quick_sort                        399738           0
+ *      quick_sort_3way                  1921271           0
+ *      intro_sort                        547565           0
+ *      heap_sort                        1574961           0
+ *      merge_sort (with aux)             100001           1
+ *      bottom_up_merge_sort              100001           1
+ *      index_sort                             9           2
+ *
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+
+#include "benchmark.h"
+#include "sort.h"
+
+using namespace std;
+
+// number of calls to operator new since the program started
+static long allocations = 0;
+
+// counts every allocation
+void* operator new(size_t size) {
+    allocations++;
+    void* p = malloc(size);
+    if (p == nullptr) throw bad_alloc();
+    return (p);
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+// a string that can only be copied, which is how the sorts treated values before they used moves
+struct CopiedString {
+    string s;
+
+    CopiedString() {}
+    CopiedString(const string& t) : s(t) {}
+    CopiedString(const CopiedString& c) : s(c.s) {}
+    CopiedString& operator=(const CopiedString& c) {
+        s = c.s;
+        return (*this);
+    }
+    bool operator<(const CopiedString& c) const { return (s < c.s); }
+};
+
+// returns the number of allocations that sorting n (prepared) values takes, excluding the array itself
+template <typename Value, typename Sort>
+long count_allocations(const string* input, const int n, Sort sort_function) {
+    Value* a = new Value[n];
+    for (auto i = 0; i < n; i++) {
+        a[i] = Value(input[i]);
+    }
+
+    auto before = allocations;
+    sort_function(a, n);
+    auto count = allocations - before;
+
+    if (!is_sorted(a, n)) {
+        cerr << "not sorted!" << endl;
+    }
+    delete[] a;
+    return (count);
+}
+
+// prints the number of allocations for the copy-only and the movable strings
+template <typename Sort>
+void run(const string& name, const string* input, const int n, Sort sort_function) {
+    cout << setw(28) << left << name << right
+         << setw(12) << count_allocations<CopiedString>(input, n, sort_function)
+         << setw(12) << count_allocations<string>(input, n, sort_function) << endl;
+    return;
+}
+
+// main entry point of the program
+int main(int argc, char* argv[]) {
+    int n = (argc == 2) ? atoi(argv[1]) : 100000;
+
+    // random strings of 24 characters
+    string* input = new string[n];
+    mt19937 rng(42);
+    for (auto i = 0; i < n; i++) {
+        input[i] = string(16, '-') + make_key<string>(rng() % n) + "!";
+    }
+
+    cout << "n = " << n << endl;
+    cout << setw(28) << left << "sort" << right << setw(12) << "copy only" << setw(12) << "moves" << endl;
+    run("insertion_sort (n/100)", input, n / 100, [](auto* a, int n) { insertion_sort(a, n); });
+    run("quick_sort", input, n, [](auto* a, int n) { quick_sort(a, 0, n-1); });
+    run("quick_sort_3way", input, n, [](auto* a, int n) { quick_sort_3way(a, 0, n-1); });
+    run("intro_sort", input, n, [](auto* a, int n) { intro_sort(a, n); });
+    run("heap_sort", input, n, [](auto* a, int n) { heap_sort(a, n); });
+    run("merge_sort (with aux)", input, n, [](auto* a, int n) {
+        auto* aux = new typename remove_reference<decltype(*a)>::type[n];
+        merge_sort(a, aux, 0, n-1);
+        delete[] aux;
+    });
+    run("bottom_up_merge_sort", input, n, [](auto* a, int n) { bottom_up_merge_sort(a, n); });
+    run("index_sort", input, n, [](auto* a, int n) { index_sort(a, n); });
+
+    delete[] input;
+    return (0);
+}
@@ -0,0 +1,146 @@
+/******************************************************************************
+ *
+ * Input generators and timing helpers for benchmarking the sorting algorithms
+ *
+ ******************************************************************************/
+
+#ifndef __BENCHMARK_H__
+#define __BENCHMARK_H__
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+
+// the input distributions used by the benchmarks
+enum Distribution { SORTED, REVERSED, ORGAN_PIPE, RANDOM, NEARLY_SORTED, FEW_UNIQUE, ZIPFIAN, SAWTOOTH };
+
+// returns a printable name of an input distribution
+inline const char* distribution_name(const Distribution d) {
+    switch (d) {
+        case SORTED:
+            return ("sorted");
+        case REVERSED:
+            return ("reversed");
+        case ORGAN_PIPE:
+            return ("organ-pipe");
+        case NEARLY_SORTED:
+            return ("nearly-sorted");
+        case FEW_UNIQUE:
+            return ("few-unique");
+        case ZIPFIAN:
+            return ("zipfian");
+        case SAWTOOTH:
+            return ("sawtooth");
+        default:
+            return ("random");
+    }
+}
+
+// Converts a non-negative integer into a key of type Value such that the order is preserved
+template <typename Value>
+Value make_key(const int x);
+
+template <>
+inline int make_key<int>(const int x) {
+    return (x);
+}
+
+template <>
+inline std::string make_key<std::string>(const int x) {
+    // seven base-26 digits cover all non-negative 32-bit integers
+    std::string s(7, 'a');
+    auto y = x;
+    for (auto i = 6; i >= 0; i--) {
+        s[i] = 'a' + y % 26;
+        y /= 26;
+    }
+    return (s);
+}
+
+// Fills the array a with n keys drawn from the given distribution
+template <typename Value>
+void fill(Value* a, const int n, const Distribution d, const unsigned seed = 42) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> uniform(0, n - 1);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    const int tooth = (n + 15) / 16;
+
+    for (auto i = 0; i < n; i++) {
+        switch (d) {
+            case SORTED:
+                a[i] = make_key<Value>(i);
+                break;
+            case REVERSED:
+                a[i] = make_key<Value>(n - 1 - i);
+                break;
+            case ORGAN_PIPE:
+                a[i] = make_key<Value>((i < n / 2) ? i : n - 1 - i);
+                break;
+            case NEARLY_SORTED:
+                // sorted except for 1% of random values, like an append-mostly log
+                a[i] = make_key<Value>((uniform(rng) % 100 == 0) ? uniform(rng) : i);
+                break;
+            case FEW_UNIQUE:
+                a[i] = make_key<Value>(uniform(rng) % 16);
+                break;
+            case ZIPFIAN:
+                // key x with probability about proportional to 1/(x+1) (continuous approximation of Zipf's law)
+                a[i] = make_key<Value>(std::min(n - 1, (int)std::exp(unit(rng) * std::log(n + 1.0)) - 1));
+                break;
+            case SAWTOOTH:
+                // 16 ascending runs of distinct keys
+                a[i] = make_key<Value>((i % tooth) * 16 + i / tooth);
+                break;
+            default:
+                a[i] = make_key<Value>(uniform(rng));
+                break;
+        }
+    }
+    return;
+}
+
+// Fills the array a with n random strings that all start with the same prefix of the given length
+inline void fill_strings(std::string* a, const int n, const int prefix_length, const unsigned seed = 42) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> uniform(0, n - 1);
+    const std::string prefix(prefix_length, 'p');
+    for (auto i = 0; i < n; i++) {
+        a[i] = prefix + make_key<std::string>(uniform(rng));
+    }
+    return;
+}
+
+// Returns the time in milliseconds that it takes to run f
+template <typename Function>
+double time_ms(Function f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return (std::chrono::duration<double, std::milli>(stop - start).count());
+}
+
+// the result of timing a sort
+struct SortTime {
+    double ms;    // time in milliseconds
+    bool sorted;  // true if the sort left the values in order
+};
+
+// Sorts a copy of the n values of input with sort(a, n) and returns the time that the sort takes (without the
+// copy) and whether the copy is sorted afterwards
+template <typename Value, typename Sort>
+SortTime time_sort(const Value* input, const int n, Sort sort) {
+    Value* a = new Value[n];
+    for (auto i = 0; i < n; i++) {
+        a[i] = input[i];
+    }
+
+    auto ms = time_ms([&]() { sort(a, n); });
+    bool sorted = std::is_sorted(a, a + n);
+
+    delete[] a;
+    return (SortTime{ms, sorted});
+}
+
+#endif
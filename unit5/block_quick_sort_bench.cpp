@@ -0,0 +1,146 @@
+/******************************************************************************
+ *
+ * Compares intro sort (with the scanning partition) and BlockQuicksort on random ints and
+ * doubles. Besides the time, the number of mispredicted branches is reported if the kernel
+ * allows reading the hardware counter with perf_event_open (Linux only).
+ *
+ *      % ./block_quick_sort_bench 10000000
+ *      n = 10000000
+ *      sort                  type          time   branch misses
+ *      intro_sort            int        ... ms           ...
+ *      block_quick_sort      int        ... ms           ...
+ *      ...
+ *
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "benchmark.h"
+#include "sort.h"
+
+using namespace std;
+
+// Implements a counter of the branch misses of this thread (that is never available outside Linux)
+class BranchMissCounter {
+   private:
+    int fd;
+
+   public:
+    // constructor that opens the hardware counter
+    BranchMissCounter() : fd(-1) {
+#ifdef __linux__
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+
+    // destructor that closes the counter
+    ~BranchMissCounter() {
+#ifdef __linux__
+        if (fd != -1) close(fd);
+#endif
+    }
+
+    // returns true if the counter can be read
+    bool available() const { return (fd != -1); }
+
+    // resets and starts the counter
+    void start() {
+#ifdef __linux__
+        if (fd == -1) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    // stops the counter and returns the number of branch misses since start (or -1)
+    long long stop() {
+        long long count = -1;
+#ifdef __linux__
+        if (fd == -1) return (count);
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != sizeof(count)) count = -1;
+#endif
+        return (count);
+    }
+};
+
+// times one sorting algorithm on a copy of the input, counts its branch misses and checks the result
+template <typename Value, typename Sort>
+void run(const string& name, const string& type_name, const Value* input, const int n,
+         BranchMissCounter& counter, Sort sort_function) {
+    long long misses = -1;
+    auto result = time_sort(input, n, [&](Value* a, int n) {
+        counter.start();
+        sort_function(a, n);
+        misses = counter.stop();
+    });
+
+    cout << setw(20) << left << name << setw(8) << type_name << right
+         << setw(11) << fixed << setprecision(2) << result.ms << " ms";
+    if (misses >= 0) {
+        cout << setw(16) << misses;
+    } else {
+        cout << setw(16) << "n/a";
+    }
+    if (!result.sorted) {
+        cout << " (not sorted!)";
+    }
+    cout << endl;
+    return;
+}
+
+// compares both sorts on n random values of type Value
+template <typename Value>
+void benchmark(const string& type_name, const int n, BranchMissCounter& counter) {
+    Value* input = new Value[n];
+    mt19937 rng(42);
+    uniform_real_distribution<double> uniform(-1e6, 1e6);
+    for (auto i = 0; i < n; i++) {
+        input[i] = static_cast<Value>(uniform(rng));
+    }
+
+    run("intro_sort", type_name, input, n, counter,
+        [](Value* a, int n) { intro_sort(a, 0, n-1, intro_sort_depth(n)); });
+    run("block_quick_sort", type_name, input, n, counter,
+        [](Value* a, int n) { block_quick_sort(a, n); });
+
+    delete[] input;
+    return;
+}
+
+// main entry point of the program
+int main(int argc, char* argv[]) {
+    int n = (argc == 2) ? atoi(argv[1]) : 10000000;
+    BranchMissCounter counter;
+
+    cout << "n = " << n << endl;
+    if (!counter.available()) {
+        cout << "(branch misses are not available: perf_event_open failed)" << endl;
+    }
+    cout << setw(20) << left << "sort" << setw(8) << "type" << right
+         << setw(14) << "time" << setw(16) << "branch misses" << endl;
+    benchmark<int>("int", n, counter);
+    benchmark<double>("double", n, counter);
+
+    return (0);
+}
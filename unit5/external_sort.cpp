@@ -0,0 +1,52 @@
+/******************************************************************************
+ *
+ * Sorts a sequence of strings of arbitrary size from a file or standard input using external
+ * merge sort: at most <memory in MB> of strings are kept in memory at once and at most <fan-in>
+ * sorted runs are merged at once. The runs are stored in $TMPDIR (or /tmp).
+ *
+ *      % ./external_sort 0.001 4 ../data/tale.txt
+ *      a                                     [ one string per line ]
+ *      a
+ *      ...
+ *      zealous
+ *      zealous
+ *
+ *      % ./external_sort 64 16 < ../data/words3.txt
+ *      all
+ *      bad
+ *      ...
+ *
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "external_sort.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    double memory_mb = (argc >= 2) ? atof(argv[1]) : 64;
+    int fan_in = (argc >= 3) ? atoi(argv[2]) : 16;
+    const char* tmp_dir = getenv("TMPDIR");
+
+    try {
+        if (argc >= 4) {
+            ifstream in(argv[3]);
+            if (!in) {
+                cerr << "Cannot open " << argv[3] << endl;
+                return (1);
+            }
+            external_sort(in, cout, memory_mb * 1024 * 1024, fan_in, tmp_dir ? tmp_dir : "/tmp");
+        } else {
+            external_sort(cin, cout, memory_mb * 1024 * 1024, fan_in, tmp_dir ? tmp_dir : "/tmp");
+        }
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        return (1);
+    }
+
+    return (0);
+}
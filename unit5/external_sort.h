@@ -0,0 +1,174 @@
+/******************************************************************************
+ *
+ * An external merge sort for sequences of strings that do not fit into main memory
+ *
+ * The input is read in chunks that fit into a given memory budget. Every chunk is sorted in
+ * memory and written to a temporary file (a run). The runs are then merged with a min priority
+ * queue that holds the current first string of every run. If there are more runs than the
+ * fan-in, groups of runs are merged into longer runs first.
+ *
+ ******************************************************************************/
+
+#ifndef __EXTERNAL_SORT_H__
+#define __EXTERNAL_SORT_H__
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "sort.h"
+#include "min_pq.h"
+
+// Implements the first string of a run together with the index of the run
+struct RunHead {
+    std::string value;
+    int run;
+
+    // orders by value and, for equal values, by run so that the merge is stable
+    bool operator>(const RunHead& h) const {
+        return ((value > h.value) || (value == h.value && run > h.run));
+    }
+};
+
+// Returns the name of a new (empty) temporary file in the directory dir
+inline std::string temporary_file(const std::string& dir) {
+    std::string name = dir + "/external_sort_XXXXXX";
+    int fd = mkstemp(&name[0]);
+    if (fd == -1) throw std::runtime_error("Cannot create a temporary file in " + dir);
+    close(fd);
+    return (name);
+}
+
+// Merges the sorted runs (one string per line) into out; throws if a run cannot be read
+inline void merge_runs(const std::vector<std::string>& runs, std::ostream& out) {
+    const int k = runs.size();
+    std::vector<std::ifstream> in(k);
+    MinPQ<RunHead> pq(k + 1);
+
+    // read the first string of every run
+    for (auto i = 0; i < k; i++) {
+        in[i].open(runs[i]);
+        if (!in[i]) throw std::runtime_error("Cannot open the run " + runs[i]);
+        RunHead head{"", i};
+        if (std::getline(in[i], head.value)) {
+            pq.insert(head);
+        }
+    }
+
+    // repeatedly output the smallest string and replace it by the next string of its run
+    while (!pq.is_empty()) {
+        RunHead head = pq.del_min();
+        out << head.value << '\n';
+        if (std::getline(in[head.run], head.value)) {
+            pq.insert(head);
+        }
+    }
+
+    // every run has to be read up to its end
+    for (auto i = 0; i < k; i++) {
+        if (in[i].bad()) throw std::runtime_error("Cannot read the run " + runs[i]);
+    }
+    return;
+}
+
+// Writes the strings to the file with the given name (one per line); throws if the file cannot be written
+// completely (e.g. because the disk is full)
+inline void write_run(const std::string& name, const std::vector<std::string>& strings) {
+    std::ofstream run(name);
+    for (auto& s : strings) {
+        run << s << '\n';
+    }
+    run.flush();
+    if (!run) throw std::runtime_error("Cannot write the run " + name);
+    return;
+}
+
+// Merges the sorted runs into the file with the given name; throws if the file cannot be written completely
+inline void merge_runs(const std::vector<std::string>& runs, const std::string& name) {
+    std::ofstream merged(name);
+    merge_runs(runs, merged);
+    merged.flush();
+    if (!merged) throw std::runtime_error("Cannot write the run " + name);
+    return;
+}
+
+// Sorts the strings read from in and writes them to out (one per line) using about memory_budget bytes of
+// memory for the strings and merging at most fan_in runs at once; the runs are stored in tmp_dir and removed
+// again, also if the sort fails with an exception
+inline void external_sort(std::istream& in, std::ostream& out, const size_t memory_budget, const int fan_in,
+                          const std::string& tmp_dir = "/tmp") {
+    if (fan_in < 2) throw std::invalid_argument("The fan-in must be at least 2");
+
+    std::vector<std::string> runs;
+    std::vector<std::string> chunk;
+    std::string token;
+    bool more = true;
+
+    try {
+        // phase 1: create sorted runs that fit into the memory budget
+        while (more) {
+            size_t used = 0;
+            chunk.clear();
+            while (used < memory_budget && (more = static_cast<bool>(in >> token))) {
+                used += sizeof(std::string) + token.capacity();
+                chunk.push_back(std::move(token));
+            }
+            if (chunk.empty()) {
+                break;
+            }
+
+            quick_sort_string(chunk.data(), chunk.size());
+
+            // a single run that holds all of the input does not need to be spilled
+            if (!more && runs.empty()) {
+                for (auto& s : chunk) {
+                    out << s << '\n';
+                }
+                out.flush();
+                if (!out) throw std::runtime_error("Cannot write the output");
+                return;
+            }
+
+            runs.push_back(temporary_file(tmp_dir));
+            write_run(runs.back(), chunk);
+        }
+        chunk.clear();
+        chunk.shrink_to_fit();
+
+        // phase 2: merge groups of fan_in runs into longer runs until at most fan_in runs are left
+        size_t first = 0;
+        while (runs.size() - first > (size_t)fan_in) {
+            std::vector<std::string> group(runs.begin() + first, runs.begin() + first + fan_in);
+            runs.push_back(temporary_file(tmp_dir));
+            merge_runs(group, runs.back());
+            for (auto& name : group) {
+                std::remove(name.c_str());
+            }
+            first += fan_in;
+        }
+
+        // phase 3: merge the remaining runs into the output
+        std::vector<std::string> last(runs.begin() + first, runs.end());
+        merge_runs(last, out);
+        out.flush();
+        if (!out) throw std::runtime_error("Cannot write the output");
+        for (auto& name : last) {
+            std::remove(name.c_str());
+        }
+    } catch (...) {
+        // remove the runs that are left (removing a run that is gone already does no harm)
+        for (auto& name : runs) {
+            std::remove(name.c_str());
+        }
+        throw;
+    }
+
+    return;
+}
+
+#endif
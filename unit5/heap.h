@@ -0,0 +1,72 @@
+/******************************************************************************
+ *
+ * A set of helper functions for heaps and Heapsort (copied from unit8)
+ *
+ * The comparison and swap helpers are called heap_less and heap_swap here because
+ * they use 1-based indexing and would otherwise clash with less and swap in sort.h. Like the
+ * sorts in sort.h, all functions take the policy of sort_policy.h for the comparisons and swaps
+ * as their first template parameter.
+ *
+ * Based on the source code from Robert Sedgewick and Kevin Wayne at https://algs4.cs.princeton.edu/
+ *
+ ******************************************************************************/
+
+#ifndef __HEAP_H__
+#define __HEAP_H__
+
+#include <utility>
+
+#include "sort_policy.h"
+
+// Implements comparison of two heap elements (assuming 1-based indexing)
+template <typename Policy = DefaultSortPolicy, typename Value>
+bool heap_less(Value* heap, const int i, const int j) {
+    return (Policy::less(heap[i - 1], heap[j - 1]));
+}
+
+// Implements a swap of element i and j in an array (assuming 1-based indexing)
+template <typename Policy = DefaultSortPolicy, typename Value>
+void heap_swap(Value* heap, const int i, const int j) {
+    Policy::swap(heap[i - 1], heap[j - 1]);
+    return;
+}
+
+// Implements the swim up function of a heap
+template <typename Policy = DefaultSortPolicy, typename Value>
+void swim(Value* heap, int k) {
+    while (k > 1 && heap_less<Policy>(heap, k / 2, k)) {
+        heap_swap<Policy>(heap, k, k / 2);
+        k = k / 2;
+    }
+}
+
+// Implements the sink function of a heap
+template <typename Policy = DefaultSortPolicy, typename Value>
+void sink(Value* heap, int k, int n) {
+    while (2 * k <= n) {
+        int j = 2 * k;
+        if (j < n && heap_less<Policy>(heap, j, j + 1)) j++;
+        if (!heap_less<Policy>(heap, k, j)) break;
+        heap_swap<Policy>(heap, k, j);
+        k = j;
+    }
+}
+
+// Implements Heap Sort
+template <typename Policy = DefaultSortPolicy, typename Value>
+void heap_sort(Value* heap, int n) {
+    // heapify phase
+    for (int k = n / 2; k >= 1; k--)
+        sink<Policy>(heap, k, n);
+
+    // sortdown phase
+    int k = n;
+    while (k > 1) {
+        heap_swap<Policy>(heap, 1, k--);
+        sink<Policy>(heap, 1, k);
+    }
+
+    return;
+}
+
+#endif
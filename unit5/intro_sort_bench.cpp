@@ -0,0 +1,73 @@
+/******************************************************************************
+ *
+ * Compares intro sort with quick sort, 3-way quick sort and merge sort on sorted,
+ * reversed, organ-pipe and random inputs of integers and strings
+ *
+ *      % ./intro_sort_bench 20000
+ *      int n = 20000
+ *      distribution    quick_sort  quick_sort_3way  merge_sort  intro_sort
+ *      sorted             ... ms          ... ms      ... ms      ... ms
+ *      ...
+ *
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "benchmark.h"
+#include "sort.h"
+
+using namespace std;
+
+// times one sorting algorithm on a copy of the input and checks the result
+template <typename Value, typename Sort>
+void run(const Value* input, const int n, Sort sort_function) {
+    auto result = time_sort(input, n, sort_function);
+    cout << setw(13) << fixed << setprecision(2) << result.ms << " ms";
+    if (!result.sorted) {
+        cout << " (not sorted!)";
+    }
+    return;
+}
+
+// runs all algorithms on all input distributions for one key type
+template <typename Value>
+void benchmark(const string& type_name, const int n) {
+    cout << type_name << " n = " << n << endl;
+    cout << setw(12) << left << "distribution" << right
+         << setw(16) << "quick_sort" << setw(16) << "quick_sort_3way"
+         << setw(16) << "merge_sort" << setw(16) << "intro_sort" << endl;
+
+    Value* input = new Value[n];
+    for (auto d : {SORTED, REVERSED, ORGAN_PIPE, RANDOM}) {
+        fill(input, n, d);
+        cout << setw(12) << left << distribution_name(d) << right;
+
+        run(input, n, [](Value* a, int n) { quick_sort(a, 0, n-1); });
+        run(input, n, [](Value* a, int n) { quick_sort_3way(a, 0, n-1); });
+        run(input, n, [](Value* a, int n) {
+            Value* aux = new Value[n];
+            merge_sort(a, aux, 0, n-1);
+            delete[] aux;
+        });
+        run(input, n, [](Value* a, int n) { intro_sort(a, n); });
+        cout << endl;
+    }
+    delete[] input;
+
+    return;
+}
+
+// main entry point of the program
+int main(int argc, char* argv[]) {
+    // quick sort needs O(n^2) time and O(n) stack on sorted inputs, so keep the default moderate
+    int n = (argc == 2) ? atoi(argv[1]) : 10000;
+
+    benchmark<int>("int", n);
+    cout << endl;
+    benchmark<string>("string", n);
+
+    return (0);
+}
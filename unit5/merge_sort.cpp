@@ -1,6 +1,7 @@
 /******************************************************************************
  *
- * Sorts a sequence of strings from standard input using merge sort
+ * Sorts a sequence of strings from standard input using LCP-aware merge sort which skips the common
+ * prefixes of neighboring strings when merging
  *
  * Based on the source code from Robert Sedgewick and Kevin Wayne at https://algs4.cs.princeton.edu/
  *
@@ -29,6 +30,8 @@ using namespace std;
 int main(void) {
     string val[MAX_STR];
     string aux[MAX_STR]; // auxiliary array for merge sort
+    int lcp[MAX_STR];     // longest common prefix of each string with its predecessor
+    int lcp_aux[MAX_STR]; // auxiliary array for the longest common prefixes
     int no_of_strings = 0;
 
     // read the strings from standard input
@@ -37,7 +40,7 @@ int main(void) {
     }
 
     // sort the strings
-    merge_sort(val, aux, 0, no_of_strings-1);
+    merge_sort_string(val, aux, lcp, lcp_aux, 0, no_of_strings-1);
 
     // print the sorted strings
     for (auto i = 0; i < no_of_strings; i++) {
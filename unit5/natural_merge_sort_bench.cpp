@@ -0,0 +1,71 @@
+/******************************************************************************
+ *
+ * Compares natural merge sort with the recursive and the bottom-up merge sort on sorted,
+ * reversed, organ-pipe, random and nearly sorted inputs of integers and strings
+ *
+ *      % ./natural_merge_sort_bench 1000000
+ *      int n = 1000000
+ *      distribution              merge_sort  bottom_up_merge_sort    natural_merge_sort
+ *      sorted                      ... ms                ... ms                ... ms
+ *      ...
+ *
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "benchmark.h"
+#include "sort.h"
+
+using namespace std;
+
+// times one sorting algorithm on a copy of the input and checks the result
+template <typename Value, typename Sort>
+void run(const Value* input, const int n, Sort sort_function) {
+    auto result = time_sort(input, n, sort_function);
+    cout << setw(19) << fixed << setprecision(2) << result.ms << " ms";
+    if (!result.sorted) {
+        cout << " (not sorted!)";
+    }
+    return;
+}
+
+// runs the merge sorts on all input distributions for one key type
+template <typename Value>
+void benchmark(const string& type_name, const int n) {
+    cout << type_name << " n = " << n << endl;
+    cout << setw(14) << left << "distribution" << right
+         << setw(22) << "merge_sort" << setw(22) << "bottom_up_merge_sort"
+         << setw(22) << "natural_merge_sort" << endl;
+
+    Value* input = new Value[n];
+    for (auto d : {SORTED, REVERSED, ORGAN_PIPE, RANDOM, NEARLY_SORTED}) {
+        fill(input, n, d);
+        cout << setw(14) << left << distribution_name(d) << right;
+
+        run(input, n, [](Value* a, int n) {
+            Value* aux = new Value[n];
+            merge_sort(a, aux, 0, n-1);
+            delete[] aux;
+        });
+        run(input, n, [](Value* a, int n) { bottom_up_merge_sort(a, n); });
+        run(input, n, [](Value* a, int n) { natural_merge_sort(a, n); });
+        cout << endl;
+    }
+    delete[] input;
+
+    return;
+}
+
+// main entry point of the program
+int main(int argc, char* argv[]) {
+    int n = (argc == 2) ? atoi(argv[1]) : 1000000;
+
+    benchmark<int>("int", n);
+    cout << endl;
+    benchmark<string>("string", n);
+
+    return (0);
+}
@@ -0,0 +1,53 @@
+/******************************************************************************
+ *
+ * Compares the parallel merge sort with the sequential merge sort on random integers and
+ * reports the speedup for 1, 2, 4, ... threads
+ *
+ *      % ./parallel_merge_sort_bench 10000000 32
+ *      merge_sort n = 10000000: ... ms
+ *      threads     time   speedup
+ *            1   ... ms      1.00
+ *            2   ... ms      ...
+ *
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include "benchmark.h"
+#include "parallel_sort.h"
+
+using namespace std;
+
+// main entry point of the program
+int main(int argc, char* argv[]) {
+    int n = (argc >= 2) ? atoi(argv[1]) : 10000000;
+    int max_threads = (argc >= 3) ? atoi(argv[2]) : thread::hardware_concurrency();
+
+    int* input = new int[n];
+    int* aux = new int[n];
+    fill(input, n, RANDOM);
+
+    // sequential baseline
+    auto serial_ms = time_sort(input, n, [&](int* a, int n) { merge_sort(a, aux, 0, n-1); }).ms;
+    cout << "merge_sort n = " << n << ": " << fixed << setprecision(2) << serial_ms << " ms" << endl;
+
+    cout << setw(8) << "threads" << setw(14) << "time" << setw(10) << "speedup" << endl;
+    for (auto threads = 1; threads <= max_threads; threads *= 2) {
+        // always finish with the maximum number of threads
+        if (threads > max_threads / 2) threads = max_threads;
+
+        auto result = time_sort(input, n, [&](int* a, int n) { parallel_merge_sort(a, n, threads); });
+        cout << setw(8) << threads << setw(11) << result.ms << " ms" << setw(10) << serial_ms / result.ms;
+        if (!result.sorted) {
+            cout << " (not sorted!)";
+        }
+        cout << endl;
+    }
+
+    delete[] input;
+    delete[] aux;
+    return (0);
+}
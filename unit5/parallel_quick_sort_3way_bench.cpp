@@ -0,0 +1,78 @@
+/******************************************************************************
+ *
+ * Measures the throughput of parallel 3-way quick sort on random integers with 2, 16 and
+ * 1024 distinct keys for 1, 2, 4, ... threads and compares it with the sequential 3-way
+ * quick sort and intro sort
+ *
+ *      % ./parallel_quick_sort_3way_bench 100000000 32
+ *      n = 100000000, 2 distinct keys
+ *      quick_sort_3way   ... ms (... M elements/s)
+ *      intro_sort        ... ms (... M elements/s)
+ *      threads     time   M elements/s   speedup
+ *            1   ... ms            ...       ...
+ *            2   ... ms            ...       ...
+ *      ...
+ *
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "benchmark.h"
+#include "parallel_sort.h"
+
+using namespace std;
+
+// times one sequential sort on a copy of the input and returns its time
+template <typename Sort>
+double run(const string& name, const int* input, const int n, Sort sort_function) {
+    auto result = time_sort(input, n, sort_function);
+    cout << setw(18) << left << name << right << fixed << setprecision(2) << result.ms << " ms ("
+         << n / result.ms / 1000 << " M elements/s)";
+    if (!result.sorted) {
+        cout << " (not sorted!)";
+    }
+    cout << endl;
+    return (result.ms);
+}
+
+// main entry point of the program
+int main(int argc, char* argv[]) {
+    int n = (argc >= 2) ? atoi(argv[1]) : 10000000;
+    int max_threads = (argc >= 3) ? atoi(argv[2]) : thread::hardware_concurrency();
+    if (max_threads < 1) max_threads = 1;
+
+    int* input = new int[n];
+    for (auto distinct : {2, 16, 1024}) {
+        mt19937 rng(42);
+        uniform_int_distribution<int> key(0, distinct - 1);
+        for (auto i = 0; i < n; i++) input[i] = key(rng);
+
+        cout << "n = " << n << ", " << distinct << " distinct keys" << endl;
+        auto serial_ms = run("quick_sort_3way", input, n, [](int* a, int n) { quick_sort_3way(a, 0, n-1); });
+        run("intro_sort", input, n, [](int* a, int n) { intro_sort(a, n); });
+
+        cout << setw(8) << "threads" << setw(14) << "time" << setw(15) << "M elements/s" << setw(10) << "speedup" << endl;
+        for (auto threads = 1; threads <= max_threads; threads *= 2) {
+            // always finish with the maximum number of threads
+            if (threads > max_threads / 2) threads = max_threads;
+
+            auto result =
+                time_sort(input, n, [&](int* a, int n) { parallel_quick_sort_3way(a, n, threads); });
+            cout << setw(8) << threads << setw(11) << result.ms << " ms" << setw(15) << n / result.ms / 1000
+                 << setw(10) << serial_ms / result.ms;
+            if (!result.sorted) {
+                cout << " (not sorted!)";
+            }
+            cout << endl;
+        }
+        cout << endl;
+    }
+
+    delete[] input;
+    return (0);
+}
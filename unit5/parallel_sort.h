@@ -0,0 +1,338 @@
+/******************************************************************************
+ *
+ * Parallel versions of the sorting algorithms in sort.h that run on a work-stealing thread pool
+ *
+ ******************************************************************************/
+
+#ifndef __PARALLEL_SORT_H__
+#define __PARALLEL_SORT_H__
+
+#include <algorithm>
+#include <random>
+
+#include "sort.h"
+#include "thread_pool.h"
+
+// subarrays of at most this many elements are sorted sequentially
+const int PARALLEL_SORT_CUTOFF = 8192;
+
+// merges of at most this many elements are not split any further
+const int PARALLEL_MERGE_CUTOFF = 16384;
+
+// Returns the number of elements that the sorted runs a[lo1..hi1] and a[lo2..hi2] contribute
+// from the first run to the first k elements of their (stable) merge
+template <typename Policy = DefaultSortPolicy, typename Value>
+int co_rank(const Value* a, const int k, const int lo1, const int hi1, const int lo2, const int hi2) {
+    const int m = hi1 - lo1 + 1, n = hi2 - lo2 + 1;
+    int i = std::min(k, m), j = k - i;
+    int i_low = std::max(0, k - n), j_low = std::max(0, k - m);
+
+    while (true) {
+        if (i > 0 && j < n && less<Policy>(a, lo2 + j, lo1 + i - 1)) {
+            // a[lo1+i-1] comes after a[lo2+j]: take fewer elements from the first run
+            auto delta = (i - i_low + 1) / 2;
+            j_low = j;
+            i -= delta;
+            j += delta;
+        } else if (j > 0 && i < m && !less<Policy>(a, lo2 + j - 1, lo1 + i)) {
+            // a[lo1+i] does not come after a[lo2+j-1]: take more elements from the first run
+            auto delta = (j - j_low + 1) / 2;
+            i_low = i;
+            i += delta;
+            j -= delta;
+        } else {
+            return (i);
+        }
+    }
+}
+
+// Moves the merge of the sorted runs src[i..mid] and src[j..hi] into dst[k..] (stable)
+template <typename Policy = DefaultSortPolicy, typename Value>
+void merge_into(Value* src, Value* dst, int i, const int mid, int j, const int hi, int k) {
+    while (i <= mid && j <= hi) {
+        if (less<Policy>(src, j, i)) {
+            Policy::move_aux(dst[k++], src[j++]);
+        } else {
+            Policy::move_aux(dst[k++], src[i++]);
+        }
+    }
+    while (i <= mid) {
+        Policy::move_aux(dst[k++], src[i++]);
+    }
+    while (j <= hi) {
+        Policy::move_aux(dst[k++], src[j++]);
+    }
+    return;
+}
+
+// Implements a parallel merge of a[lo..mid] and a[mid+1..hi] which splits the output at co-ranks
+template <typename Policy = DefaultSortPolicy, typename Value>
+void parallel_merge(ThreadPool& pool, Value* a, Value* aux, const int lo, const int mid, const int hi) {
+    const int n = hi - lo + 1;
+    const int pieces = (n + PARALLEL_MERGE_CUTOFF - 1) / PARALLEL_MERGE_CUTOFF;
+
+    // move to aux[] in parallel
+    TaskGroup copy;
+    for (auto p = 0; p < pieces; p++) {
+        pool.spawn(copy, [=]() {
+            for (auto k = lo + p * PARALLEL_MERGE_CUTOFF; k <= std::min(hi, lo + (p + 1) * PARALLEL_MERGE_CUTOFF - 1); k++) {
+                Policy::move_aux(aux[k], a[k]);
+            }
+        });
+    }
+    pool.wait(copy);
+
+    // split the output into pieces (before any piece moves values out of aux[])
+    int* split = new int[pieces + 1];
+    TaskGroup ranks;
+    for (auto p = 0; p <= pieces; p++) {
+        pool.spawn(ranks, [=]() { split[p] = co_rank<Policy>(aux, std::min(n, p * PARALLEL_MERGE_CUTOFF), lo, mid, mid + 1, hi); });
+    }
+    pool.wait(ranks);
+
+    // merge back to a[] where every piece writes a contiguous range of the output
+    TaskGroup merge;
+    for (auto p = 0; p < pieces; p++) {
+        pool.spawn(merge, [=]() {
+            const int k1 = p * PARALLEL_MERGE_CUTOFF;
+            const int k2 = std::min(n, (p + 1) * PARALLEL_MERGE_CUTOFF);
+            merge_into<Policy>(aux, a, lo + split[p], lo + split[p + 1] - 1, mid + 1 + k1 - split[p], mid + k2 - split[p + 1], lo + k1);
+        });
+    }
+    pool.wait(merge);
+    delete[] split;
+
+    return;
+}
+
+// Implements the recursive parallel merge sort of a[lo..hi]
+template <typename Policy = DefaultSortPolicy, typename Value>
+void parallel_merge_sort(ThreadPool& pool, Value* a, Value* aux, const int lo, const int hi) {
+    if (hi - lo + 1 <= PARALLEL_SORT_CUTOFF) {
+        merge_sort<Policy>(a, aux, lo, hi);
+        return;
+    }
+    auto mid = lo + (hi - lo) / 2;
+    TaskGroup halves;
+    pool.spawn(halves, [=, &pool]() { parallel_merge_sort<Policy>(pool, a, aux, lo, mid); });
+    parallel_merge_sort<Policy>(pool, a, aux, mid+1, hi);
+    pool.wait(halves);
+
+    // no need to merge if the two halves are already in order
+    if (!less<Policy>(a, mid+1, mid)) {
+        return;
+    }
+    parallel_merge<Policy>(pool, a, aux, lo, mid, hi);
+    return;
+}
+
+// Implements the parallel merge sort of the array a with n elements on the given number of threads
+template <typename Policy = DefaultSortPolicy, typename Value>
+void parallel_merge_sort(Value* a, const int n, const int threads) {
+    Value* aux = new Value[n];
+    ThreadPool pool(threads);
+    parallel_merge_sort<Policy>(pool, a, aux, 0, n-1);
+    delete[] aux;
+    return;
+}
+
+// Implements the parallel 3-way quick sort of a[lo..hi] with a bounded partitioning depth: every partition
+// (partition_3way) splits off the keys equal to the pivot, which are never looked at again, and the smaller
+// of the two other parts is spawned as a task if it is large enough while the loop continues on the larger
+// one. Once the depth limit is exceeded, the rest of the range is sorted with heap sort.
+template <typename Policy = DefaultSortPolicy, typename Value>
+void parallel_quick_sort_3way(ThreadPool& pool, Value* a, int lo, int hi, int depth_limit) {
+    TaskGroup parts;
+    while (hi - lo + 1 > INTRO_SORT_CUTOFF) {
+        if (depth_limit == 0) {
+            heap_sort<Policy>(a + lo, hi - lo + 1);
+            pool.wait(parts);
+            return;
+        }
+        depth_limit--;
+
+        swap<Policy>(a, lo, choose_pivot<Policy>(a, lo, hi));
+        int lt, gt;
+        partition_3way<Policy>(a, lo, hi, lt, gt);
+
+        auto l = lo, h = lt-1;
+        if (lt - lo < hi - gt) {
+            lo = gt+1;
+        } else {
+            l = gt+1;
+            h = hi;
+            hi = lt-1;
+        }
+        if (h - l + 1 > PARALLEL_SORT_CUTOFF) {
+            pool.spawn(parts, [=, &pool]() { parallel_quick_sort_3way<Policy>(pool, a, l, h, depth_limit); });
+        } else {
+            parallel_quick_sort_3way<Policy>(pool, a, l, h, depth_limit);
+        }
+    }
+    insertion_sort<Policy>(a, lo, hi);
+    pool.wait(parts);
+    return;
+}
+
+// Implements the parallel 3-way quick sort of the array a with n elements on the given number of threads,
+// which is fastest on inputs with many duplicate keys
+template <typename Policy = DefaultSortPolicy, typename Value>
+void parallel_quick_sort_3way(Value* a, const int n, const int threads) {
+    ThreadPool pool(threads);
+    parallel_quick_sort_3way<Policy>(pool, a, 0, n-1, intro_sort_depth(n));
+    return;
+}
+
+// number of buckets of sample sort (a power of two of at most 256, so that a bucket number fits into a byte)
+const int SAMPLE_SORT_BUCKETS = 256;
+
+// number of samples per bucket from which the splitters are picked
+const int SAMPLE_SORT_OVERSAMPLING = 16;
+
+// inputs of at most this many elements are sorted sequentially by sample sort
+const int SAMPLE_SORT_CUTOFF = 1 << 16;
+
+// Stores the sorted splitters s[lo..hi] as an implicit binary search tree in tree[] (in Eytzinger order: the
+// children of node j are 2j and 2j+1) by an in-order traversal starting at node j
+template <typename Value>
+void build_splitter_tree(const Value* s, Value* tree, const int j, const int k, int& next) {
+    if (j >= k) {
+        return;
+    }
+    build_splitter_tree(s, tree, 2 * j, k, next);
+    tree[j] = s[next++];
+    build_splitter_tree(s, tree, 2 * j + 1, k, next);
+    return;
+}
+
+// Returns the bucket of x (b such that s[b-1] < x <= s[b]) by descending the splitter tree without branches
+template <typename Policy = DefaultSortPolicy, typename Value>
+int classify(const Value* tree, const int k, const Value& x) {
+    auto j = 1;
+    while (j < k) {
+        j = 2 * j + Policy::less(tree[j], x);
+    }
+    return (j - k);
+}
+
+// Returns the bucket of x with equality buckets, for splitter trees with equal splitters: 2b for
+// s[b-1] < x < s[b] and 2b+1 for x == s[b], where b is the bucket of classify and s the sorted splitters
+template <typename Policy = DefaultSortPolicy, typename Value>
+int classify_equal(const Value* tree, const Value* s, const int k, const Value& x) {
+    auto b = classify<Policy>(tree, k, x);
+    return (2 * b + (b < k - 1 && !Policy::less(x, s[b])));
+}
+
+// Implements parallel sample sort of the array a with n elements on the given number of threads: splitters
+// picked from a random sample split the values into buckets; every thread classifies and then scatters a
+// contiguous block of the input using its own bucket counts, and the buckets are sorted independently. If
+// the sample has equal splitters (many duplicate keys), half as many splitters are used and the keys equal to
+// a splitter go into an equality bucket of their own, which needs no sorting (as in IPS4o)
+template <typename Policy = DefaultSortPolicy, typename Value>
+void sample_sort(Value* a, const int n, const int threads) {
+    if (n <= SAMPLE_SORT_CUTOFF) {
+        intro_sort<Policy>(a, n);
+        return;
+    }
+    const int k = SAMPLE_SORT_BUCKETS;
+    const int blocks = std::max(threads, 1);
+
+    // pick k-1 splitters from a sorted random sample
+    const int samples = k * SAMPLE_SORT_OVERSAMPLING;
+    Value* sample = new Value[samples];
+    std::mt19937 rng(n);
+    std::uniform_int_distribution<int> uniform(0, n - 1);
+    for (auto i = 0; i < samples; i++) {
+        sample[i] = a[uniform(rng)];
+    }
+    intro_sort<Policy>(sample, samples);
+    Value* splitters = new Value[k - 1];
+    for (auto i = 0; i < k - 1; i++) {
+        splitters[i] = std::move(sample[(i + 1) * SAMPLE_SORT_OVERSAMPLING - 1]);
+    }
+    delete[] sample;
+
+    // with equal splitters every other splitter is kept, so that with the equality buckets there are k again
+    auto equal_buckets = false;
+    for (auto i = 1; i < k - 1; i++) {
+        if (!Policy::less(splitters[i-1], splitters[i])) equal_buckets = true;
+    }
+    const int tree_k = equal_buckets ? k / 2 : k;
+    if (equal_buckets) {
+        for (auto i = 0; i < tree_k - 1; i++) {
+            splitters[i] = std::move(splitters[2 * i + 1]);
+        }
+    }
+    Value* tree = new Value[tree_k];
+    auto next = 0;
+    build_splitter_tree(splitters, tree, 1, tree_k, next);
+
+    ThreadPool pool(threads);
+    unsigned char* bucket = new unsigned char[n];
+    int* count = new int[blocks * k]();  // count[t*k+b]: number of values of block t in bucket b
+    auto block_lo = [=](const int t) { return ((int)((long long)n * t / blocks)); };
+
+    // classify the values of every block
+    TaskGroup classification;
+    for (auto t = 0; t < blocks; t++) {
+        pool.spawn(classification, [=]() {
+            int* c = count + t * k;
+            for (auto i = block_lo(t); i < block_lo(t + 1); i++) {
+                bucket[i] = equal_buckets ? classify_equal<Policy>(tree, splitters, tree_k, a[i])
+                                          : classify<Policy>(tree, k, a[i]);
+                c[bucket[i]]++;
+            }
+        });
+    }
+    pool.wait(classification);
+
+    // turn the counts into the positions at which every block writes its values of every bucket
+    int* bucket_lo = new int[k + 1];
+    auto sum = 0;
+    for (auto b = 0; b < k; b++) {
+        bucket_lo[b] = sum;
+        for (auto t = 0; t < blocks; t++) {
+            auto c = count[t * k + b];
+            count[t * k + b] = sum;
+            sum += c;
+        }
+    }
+    bucket_lo[k] = n;
+
+    // scatter the values of every block into its ranges of the buckets
+    Value* aux = new Value[n];
+    TaskGroup scatter;
+    for (auto t = 0; t < blocks; t++) {
+        pool.spawn(scatter, [=]() {
+            int* position = count + t * k;
+            for (auto i = block_lo(t); i < block_lo(t + 1); i++) {
+                Policy::move_aux(aux[position[bucket[i]]++], a[i]);
+            }
+        });
+    }
+    pool.wait(scatter);
+
+    // sort every bucket (but the equality buckets, whose keys are all equal) and move it back
+    TaskGroup buckets;
+    for (auto b = 0; b < k; b++) {
+        pool.spawn(buckets, [=]() {
+            if (!equal_buckets || b % 2 == 0) {
+                intro_sort<Policy>(aux + bucket_lo[b], bucket_lo[b + 1] - bucket_lo[b]);
+            }
+            for (auto i = bucket_lo[b]; i < bucket_lo[b + 1]; i++) {
+                Policy::move_aux(a[i], aux[i]);
+            }
+        });
+    }
+    pool.wait(buckets);
+
+    delete[] aux;
+    delete[] bucket_lo;
+    delete[] count;
+    delete[] bucket;
+    delete[] tree;
+    delete[] splitters;
+    return;
+}
+
+#endif
@@ -0,0 +1,70 @@
+/******************************************************************************
+ *
+ * Compares partial sort and select with a full intro sort (followed by taking the first k
+ * values) for k = 10, 1000 and n/10 on random integers
+ *
+ *      % ./partial_sort_bench 10000000
+ *      n = 10000000
+ *             k     full sort   partial_sort        select
+ *            10      ... ms         ... ms        ... ms
+ *          1000      ... ms         ... ms        ... ms
+ *       1000000      ... ms         ... ms        ... ms
+ *
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include "benchmark.h"
+#include "sort.h"
+
+using namespace std;
+
+// returns true if a[0..k-1] are the k smallest values of the sorted reference in sorted order
+bool is_prefix(const int* a, const int* sorted, const int k) {
+    for (auto i = 0; i < k; i++) {
+        if (a[i] != sorted[i]) return (false);
+    }
+    return (true);
+}
+
+// main entry point of the program
+int main(int argc, char* argv[]) {
+    int n = (argc == 2) ? atoi(argv[1]) : 10000000;
+
+    int* input = new int[n];
+    int* sorted = new int[n];
+    int* a = new int[n];
+    fill(input, n, RANDOM);
+    for (auto i = 0; i < n; i++) sorted[i] = input[i];
+    intro_sort(sorted, n);
+
+    cout << "n = " << n << endl;
+    cout << setw(10) << "k" << setw(14) << "full sort" << setw(15) << "partial_sort" << setw(14) << "select" << endl;
+    for (auto k : {10, 1000, n / 10}) {
+        if (k < 1 || k > n) continue;
+        cout << setw(10) << k;
+
+        for (auto i = 0; i < n; i++) a[i] = input[i];
+        auto ms = time_ms([&]() { intro_sort(a, n); });
+        cout << setw(11) << fixed << setprecision(2) << ms << " ms";
+
+        for (auto i = 0; i < n; i++) a[i] = input[i];
+        ms = time_ms([&]() { partial_sort(a, n, k); });
+        cout << setw(12) << ms << " ms";
+        if (!is_prefix(a, sorted, k)) cout << " (wrong!)";
+
+        for (auto i = 0; i < n; i++) a[i] = input[i];
+        int kth = 0;
+        ms = time_ms([&]() { kth = select(a, n, k-1); });
+        cout << setw(11) << ms << " ms";
+        if (kth != sorted[k-1]) cout << " (wrong!)";
+        cout << endl;
+    }
+
+    delete[] input;
+    delete[] sorted;
+    delete[] a;
+    return (0);
+}
@@ -1,6 +1,7 @@
 /******************************************************************************
  *
- * Sorts a sequence of strings from standard input using quick sort
+ * Sorts a sequence of strings from standard input using 3-way string quick sort which partitions
+ * on one character at a time instead of comparing whole strings
  *
  * Based on the source code from Robert Sedgewick and Kevin Wayne at https://algs4.cs.princeton.edu/
  *
@@ -36,7 +37,7 @@ int main(void) {
     }
 
     // sort the strings
-    quick_sort(val, 0, no_of_strings-1);
+    quick_sort_string(val, 0, no_of_strings-1);
 
     // print the sorted strings
     for (auto i = 0; i < no_of_strings; i++) {
@@ -0,0 +1,42 @@
+/******************************************************************************
+ *
+ * Sorts a sequence of integers from standard input using LSD radix sort
+ *
+ *      % more 8ints.txt
+ *      30 -30 -20 -10 40 0 10 15             [ one integer per line ]
+ *
+ *      % ./radix_sort < ../data/8ints.txt
+ *      -30 -20 -10 0 10 15 30 40
+ *
+ *      % ./radix_sort < ../data/1Kints.txt
+ *      -998166 -996360 ... 994005 998473     [ 1000 integers ]
+ *
+ ******************************************************************************/
+
+#include <iostream>
+#include <vector>
+#include "sort.h"
+
+using namespace std;
+
+int main(void) {
+    vector<int> val;
+    int x;
+
+    // read the integers from standard input
+    while (cin >> x) {
+        val.push_back(x);
+    }
+
+    // sort the integers
+    const int n = (int)val.size();
+    lsd_radix_sort(val.data(), n);
+
+    // print the sorted integers
+    for (auto i = 0; i < n; i++) {
+        cout << val[i] << " ";
+    }
+    cout << endl;
+
+    return 0;
+}
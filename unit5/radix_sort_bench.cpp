@@ -0,0 +1,61 @@
+/******************************************************************************
+ *
+ * Compares LSD radix sort with 3-way quick sort on random (signed) integers of
+ * 1M, 10M, ... elements up to the given maximum size
+ *
+ *      % ./radix_sort_bench 100000000
+ *             n  quick_sort_3way  lsd_radix_sort
+ *       1000000          ... ms          ... ms
+ *      10000000          ... ms          ... ms
+ *     100000000          ... ms          ... ms
+ *
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#include "benchmark.h"
+#include "sort.h"
+
+using namespace std;
+
+// times one sorting algorithm on a copy of the input and checks the result
+template <typename Sort>
+void run(const int* input, const int n, Sort sort_function) {
+    auto result = time_sort(input, n, sort_function);
+    cout << setw(13) << fixed << setprecision(2) << result.ms << " ms";
+    if (!result.sorted) {
+        cout << " (not sorted!)";
+    }
+    return;
+}
+
+// main entry point of the program
+int main(int argc, char* argv[]) {
+    int max_n = (argc == 2) ? atoi(argv[1]) : 10000000;
+
+    cout << setw(10) << "n" << setw(16) << "quick_sort_3way" << setw(16) << "lsd_radix_sort" << endl;
+    for (auto n = 1000000; n <= max_n; n *= 10) {
+        int* input = new int[n];
+
+        // random integers from the full (signed) range
+        mt19937 rng(42);
+        for (auto i = 0; i < n; i++) {
+            input[i] = static_cast<int>(rng());
+        }
+
+        cout << setw(10) << n;
+        run(input, n, [](int* a, int n) { quick_sort_3way(a, 0, n-1); });
+        run(input, n, [](int* a, int n) { lsd_radix_sort(a, n); });
+        cout << endl;
+
+        delete[] input;
+
+        // stop before n overflows
+        if (n > max_n / 10) break;
+    }
+
+    return (0);
+}
@@ -0,0 +1,59 @@
+/******************************************************************************
+ *
+ * Measures the throughput of parallel sample sort for 1, 2, 4, ... threads on random integers
+ * and on integers with many duplicates (16 distinct keys, and Zipf-distributed keys), and
+ * compares it with the sequential intro sort
+ *
+ *      % ./sample_sort_bench 10000000 32
+ *      random intro_sort n = 10000000: ... ms (... M elements/s)
+ *      threads     time   M elements/s   speedup
+ *            1   ... ms            ...       ...
+ *            2   ... ms            ...       ...
+ *      ...
+ *
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include "benchmark.h"
+#include "parallel_sort.h"
+
+using namespace std;
+
+// main entry point of the program
+int main(int argc, char* argv[]) {
+    int n = (argc >= 2) ? atoi(argv[1]) : 10000000;
+    int max_threads = (argc >= 3) ? atoi(argv[2]) : thread::hardware_concurrency();
+
+    int* input = new int[n];
+    for (auto d : {RANDOM, FEW_UNIQUE, ZIPFIAN}) {
+        fill(input, n, d);
+
+        // sequential baseline
+        auto serial_ms = time_sort(input, n, [](int* a, int n) { intro_sort(a, n); }).ms;
+        cout << distribution_name(d) << " intro_sort n = " << n << ": " << fixed << setprecision(2) << serial_ms
+             << " ms (" << n / serial_ms / 1000 << " M elements/s)" << endl;
+
+        cout << setw(8) << "threads" << setw(14) << "time" << setw(15) << "M elements/s" << setw(10) << "speedup"
+             << endl;
+        for (auto threads = 1; threads <= max_threads; threads *= 2) {
+            // always finish with the maximum number of threads
+            if (threads > max_threads / 2) threads = max_threads;
+
+            auto result = time_sort(input, n, [&](int* a, int n) { sample_sort(a, n, threads); });
+            cout << setw(8) << threads << setw(11) << result.ms << " ms" << setw(15) << n / result.ms / 1000
+                 << setw(10) << serial_ms / result.ms;
+            if (!result.sorted) {
+                cout << " (not sorted!)";
+            }
+            cout << endl;
+        }
+        cout << endl;
+    }
+
+    delete[] input;
+    return (0);
+}
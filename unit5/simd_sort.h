@@ -0,0 +1,298 @@
+/******************************************************************************
+ *
+ * Vectorized kernels for sorting int, float and double arrays: a partition that uses AVX2
+ * compares and lane permutations instead of branches, and bitonic sorting networks for
+ * small subarrays. The sorting networks consist of branch-free min/max steps over contiguous
+ * blocks that the compiler vectorizes.
+ *
+ * SimdSort<Value> is specialized for int, float and double only, so all other types (e.g.
+ * strings) keep using the generic code in sort.h. The specializations are only enabled when
+ * the compiler targets AVX2 (-mavx2 or -march=native, which the Makefile passes for make SIMD=1
+ * and always for simd_sort_bench); otherwise these types use the generic code as well, which is
+ * faster than the partition without vector instructions.
+ *
+ ******************************************************************************/
+
+#ifndef __SIMD_SORT_H__
+#define __SIMD_SORT_H__
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Implements the partition of a[lo..hi-1] into the values that do not go right and the values that go
+// right (x >= pivot, or x > pivot if or_equal is set) with two scans from both ends
+template <typename Value>
+int scalar_partition(Value* a, const int lo, const int hi, const Value pivot, const bool or_equal) {
+    auto goes_right = [&](const Value& x) { return (or_equal ? (pivot < x) : !(x < pivot)); };
+    int i = lo, j = hi - 1;
+    while (true) {
+        while (i <= j && !goes_right(a[i])) i++;
+        while (i <= j && goes_right(a[j])) j--;
+        if (i >= j) break;
+        std::swap(a[i], a[j]);
+        i++;
+        j--;
+    }
+    return (i);
+}
+
+// Implements the bitonic sorting network on the n values of a where n is a power of two
+template <typename Value>
+void bitonic_network(Value* a, const int n) {
+    for (auto k = 2; k <= n; k *= 2) {
+        for (auto j = k / 2; j > 0; j /= 2) {
+            // compare-exchange a[x] with a[x+j]; the direction only changes every k values
+            for (auto base = 0; base < n; base += 2 * j) {
+                const bool ascending = ((base & k) == 0);
+                Value* x = a + base;
+                Value* y = a + base + j;
+                for (auto t = 0; t < j; t++) {
+                    const Value lo = (y[t] < x[t]) ? y[t] : x[t];
+                    const Value hi = (y[t] < x[t]) ? x[t] : y[t];
+                    x[t] = ascending ? lo : hi;
+                    y[t] = ascending ? hi : lo;
+                }
+            }
+        }
+    }
+    return;
+}
+
+// Implements the sorting of n <= 64 values with a bitonic network of 16, 32 or 64 inputs (padded with
+// the largest value of the type)
+template <typename Value>
+void bitonic_sort(Value* a, const int n) {
+    alignas(32) Value buf[64];
+    int size = 16;
+    while (size < n) {
+        size *= 2;
+    }
+
+    const Value pad = std::numeric_limits<Value>::has_infinity ? std::numeric_limits<Value>::infinity()
+                                                               : std::numeric_limits<Value>::max();
+    for (auto i = 0; i < n; i++) buf[i] = a[i];
+    for (auto i = n; i < size; i++) buf[i] = pad;
+
+    bitonic_network(buf, size);
+
+    for (auto i = 0; i < n; i++) a[i] = buf[i];
+    return;
+}
+
+#ifdef __AVX2__
+// Implements the tables of lane permutations that move the lanes going left in front of the lanes going
+// right (in their original order) for every mask of lanes going right
+struct PartitionTables {
+    alignas(32) int32_t perm8[256][8];  // for 8 lanes of 32 bits
+    alignas(32) int32_t perm4[16][8];   // for 4 lanes of 64 bits (as pairs of 32-bit lanes)
+
+    // constructor that computes all permutations
+    PartitionTables() {
+        for (auto mask = 0; mask < 256; mask++) {
+            auto k = 0;
+            for (auto lane = 0; lane < 8; lane++)
+                if (!(mask & (1 << lane))) perm8[mask][k++] = lane;
+            for (auto lane = 0; lane < 8; lane++)
+                if (mask & (1 << lane)) perm8[mask][k++] = lane;
+        }
+        for (auto mask = 0; mask < 16; mask++) {
+            auto k = 0;
+            for (auto lane = 0; lane < 4; lane++)
+                if (!(mask & (1 << lane))) { perm4[mask][k++] = 2 * lane; perm4[mask][k++] = 2 * lane + 1; }
+            for (auto lane = 0; lane < 4; lane++)
+                if (mask & (1 << lane)) { perm4[mask][k++] = 2 * lane; perm4[mask][k++] = 2 * lane + 1; }
+        }
+    }
+};
+
+// returns the (only) instance of the permutation tables
+inline const PartitionTables& partition_tables() {
+    static const PartitionTables tables;
+    return (tables);
+}
+
+// Implements the AVX2 operations of the partition on 8 ints
+struct Avx2Int {
+    using Value = int;
+    using Vector = __m256i;
+    static const int lanes = 8;
+
+    static Vector load(const int* p) { return (_mm256_loadu_si256((const __m256i*)p)); }
+    static void store(int* p, const Vector v) { _mm256_storeu_si256((__m256i*)p, v); }
+    static Vector broadcast(const int x) { return (_mm256_set1_epi32(x)); }
+
+    // returns the mask of the lanes that go right
+    static int right_mask(const Vector v, const Vector pivot, const bool or_equal) {
+        if (or_equal) {
+            return (_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, pivot))));
+        }
+        return (~_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(pivot, v))) & 0xff);
+    }
+
+    // moves the lanes that go left in front of the lanes that go right
+    static Vector permute(const Vector v, const int mask) {
+        return (_mm256_permutevar8x32_epi32(v, _mm256_load_si256((const __m256i*)partition_tables().perm8[mask])));
+    }
+};
+
+// Implements the AVX2 operations of the partition on 8 floats
+struct Avx2Float {
+    using Value = float;
+    using Vector = __m256;
+    static const int lanes = 8;
+
+    static Vector load(const float* p) { return (_mm256_loadu_ps(p)); }
+    static void store(float* p, const Vector v) { _mm256_storeu_ps(p, v); }
+    static Vector broadcast(const float x) { return (_mm256_set1_ps(x)); }
+
+    // returns the mask of the lanes that go right
+    static int right_mask(const Vector v, const Vector pivot, const bool or_equal) {
+        if (or_equal) {
+            return (_mm256_movemask_ps(_mm256_cmp_ps(v, pivot, _CMP_GT_OQ)));
+        }
+        return (_mm256_movemask_ps(_mm256_cmp_ps(v, pivot, _CMP_NLT_UQ)));
+    }
+
+    // moves the lanes that go left in front of the lanes that go right
+    static Vector permute(const Vector v, const int mask) {
+        return (_mm256_permutevar8x32_ps(v, _mm256_load_si256((const __m256i*)partition_tables().perm8[mask])));
+    }
+};
+
+// Implements the AVX2 operations of the partition on 4 doubles
+struct Avx2Double {
+    using Value = double;
+    using Vector = __m256d;
+    static const int lanes = 4;
+
+    static Vector load(const double* p) { return (_mm256_loadu_pd(p)); }
+    static void store(double* p, const Vector v) { _mm256_storeu_pd(p, v); }
+    static Vector broadcast(const double x) { return (_mm256_set1_pd(x)); }
+
+    // returns the mask of the lanes that go right
+    static int right_mask(const Vector v, const Vector pivot, const bool or_equal) {
+        if (or_equal) {
+            return (_mm256_movemask_pd(_mm256_cmp_pd(v, pivot, _CMP_GT_OQ)));
+        }
+        return (_mm256_movemask_pd(_mm256_cmp_pd(v, pivot, _CMP_NLT_UQ)));
+    }
+
+    // moves the lanes that go left in front of the lanes that go right
+    static Vector permute(const Vector v, const int mask) {
+        const __m256i perm = _mm256_load_si256((const __m256i*)partition_tables().perm4[mask]);
+        return (_mm256_castps_pd(_mm256_permutevar8x32_ps(_mm256_castpd_ps(v), perm)));
+    }
+};
+
+// Implements the in-place vectorized partition of a[lo..hi-1]: every vector is permuted such that its left
+// values come first and then stored both at the end of the left part and at the front of the right part.
+// The first and last vector are kept in registers, which guarantees that both stores only overwrite values
+// that were already read (the side with less free space is read next).
+template <typename Lanes>
+int avx2_partition(typename Lanes::Value* a, const int lo, const int hi, const typename Lanes::Value pivot,
+                   const bool or_equal) {
+    using Value = typename Lanes::Value;
+    const int n = Lanes::lanes;
+    if (hi - lo < 2 * n) {
+        return (scalar_partition(a, lo, hi, pivot, or_equal));
+    }
+
+    const auto p = Lanes::broadcast(pivot);
+    const auto first = Lanes::load(a + lo);
+    const auto last = Lanes::load(a + hi - n);
+    int l = lo + n, r = hi - n;  // a[l..r-1] has not been read yet
+    int wl = lo, wr = hi;        // a[lo..wl-1] goes left and a[wr..hi-1] goes right
+
+    while (r - l >= n) {
+        typename Lanes::Vector v;
+        if (l - wl <= wr - r) {
+            v = Lanes::load(a + l);
+            l += n;
+        } else {
+            r -= n;
+            v = Lanes::load(a + r);
+        }
+        const int mask = Lanes::right_mask(v, p, or_equal);
+        const int right = __builtin_popcount(mask);
+        const auto w = Lanes::permute(v, mask);
+        Lanes::store(a + wl, w);
+        Lanes::store(a + wr - n, w);
+        wl += n - right;
+        wr -= right;
+    }
+
+    // the unread rest and the two saved vectors fill the gap a[wl..wr-1] exactly
+    Value buf[3 * n];
+    auto m = 0;
+    for (auto i = l; i < r; i++) buf[m++] = a[i];
+    Lanes::store(buf + m, first);
+    m += n;
+    Lanes::store(buf + m, last);
+    m += n;
+    for (auto i = 0; i < m; i++) {
+        if (or_equal ? (pivot < buf[i]) : !(buf[i] < pivot)) {
+            a[--wr] = buf[i];
+        } else {
+            a[wl++] = buf[i];
+        }
+    }
+    return (wl);
+}
+#endif
+
+// Implements the selection of the vectorized kernels; the generic version has none
+template <typename Value>
+struct SimdSort {
+    static const bool enabled = false;
+};
+
+#ifdef __AVX2__
+// Implements the vectorized kernels for int
+template <>
+struct SimdSort<int> {
+    static const bool enabled = true;
+
+    // partitions a[lo..hi] such that a[lo..m-1] < pivot <= a[m..hi] (or <= pivot < if or_equal) and returns m
+    static int partition(int* a, const int lo, const int hi, const int pivot, const bool or_equal) {
+        return (avx2_partition<Avx2Int>(a, lo, hi + 1, pivot, or_equal));
+    }
+
+    // sorts the n <= 64 values of a
+    static void sort_network(int* a, const int n) { bitonic_sort(a, n); }
+};
+
+// Implements the vectorized kernels for float
+template <>
+struct SimdSort<float> {
+    static const bool enabled = true;
+
+    // partitions a[lo..hi] such that a[lo..m-1] < pivot <= a[m..hi] (or <= pivot < if or_equal) and returns m
+    static int partition(float* a, const int lo, const int hi, const float pivot, const bool or_equal) {
+        return (avx2_partition<Avx2Float>(a, lo, hi + 1, pivot, or_equal));
+    }
+
+    // sorts the n <= 64 values of a
+    static void sort_network(float* a, const int n) { bitonic_sort(a, n); }
+};
+
+// Implements the vectorized kernels for double
+template <>
+struct SimdSort<double> {
+    static const bool enabled = true;
+
+    // partitions a[lo..hi] such that a[lo..m-1] < pivot <= a[m..hi] (or <= pivot < if or_equal) and returns m
+    static int partition(double* a, const int lo, const int hi, const double pivot, const bool or_equal) {
+        return (avx2_partition<Avx2Double>(a, lo, hi + 1, pivot, or_equal));
+    }
+
+    // sorts the n <= 64 values of a
+    static void sort_network(double* a, const int n) { bitonic_sort(a, n); }
+};
+#endif
+
+#endif
@@ -0,0 +1,71 @@
+/******************************************************************************
+ *
+ * Compares the generic intro sort with the intro sort that uses the vectorized partition and
+ * sorting networks of simd_sort.h on random ints, floats and doubles
+ *
+ *      % ./simd_sort_bench 10000000
+ *      n = 10000000 (AVX2)
+ *      type        generic        simd
+ *      int      ... ms      ... ms
+ *      float    ... ms      ... ms
+ *      double   ... ms      ... ms
+ *
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "benchmark.h"
+#include "sort.h"
+
+using namespace std;
+
+// times one sorting algorithm on a copy of the input and checks the result
+template <typename Value, typename Sort>
+void run(const Value* input, const int n, Sort sort_function) {
+    auto result = time_sort(input, n, sort_function);
+    cout << setw(11) << fixed << setprecision(2) << result.ms << " ms";
+    if (!result.sorted) {
+        cout << " (not sorted!)";
+    }
+    return;
+}
+
+// compares the generic and the vectorized intro sort on n random values
+template <typename Value>
+void benchmark(const string& type_name, const int n) {
+    Value* input = new Value[n];
+    mt19937 rng(42);
+    uniform_real_distribution<double> uniform(-1e6, 1e6);
+    for (auto i = 0; i < n; i++) {
+        input[i] = static_cast<Value>(uniform(rng));
+    }
+
+    cout << setw(8) << left << type_name << right;
+    run(input, n, [](Value* a, int n) { intro_sort(a, 0, n-1, intro_sort_depth(n)); });
+    run(input, n, [](Value* a, int n) { intro_sort(a, n); });
+    cout << endl;
+
+    delete[] input;
+    return;
+}
+
+// main entry point of the program
+int main(int argc, char* argv[]) {
+    int n = (argc == 2) ? atoi(argv[1]) : 10000000;
+
+#ifdef __AVX2__
+    cout << "n = " << n << " (AVX2)" << endl;
+#else
+    cout << "n = " << n << " (scalar)" << endl;
+#endif
+    cout << setw(8) << left << "type" << right << setw(14) << "generic" << setw(14) << "simd" << endl;
+    benchmark<int>("int", n);
+    benchmark<float>("float", n);
+    benchmark<double>("double", n);
+
+    return (0);
+}
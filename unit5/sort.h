@@ -9,19 +9,28 @@
 #ifndef __INSERTION_H__
 #define __INSERTION_H__
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
 
-// Implements comparison of two array elements 
-template <typename Value>
+#include "heap.h"
+#include "simd_sort.h"
+#include "sort_policy.h"
+
+
+// Implements comparison of two array elements (through the policy, see sort_policy.h)
+template <typename Policy = DefaultSortPolicy, typename Value>
 bool less(const Value* a, const int i, const int j) {
-    return (a[i] < a[j]);
+    return (Policy::less(a[i], a[j]));
 }
 
-// Implements a swap of element i and j in an array 
-template <typename Value>
+// Implements a swap of element i and j in an array (through the policy, which moves instead of copying)
+template <typename Policy = DefaultSortPolicy, typename Value>
 void swap(Value* a, const int i, const int j) {
-    const Value tmp = a[i];
-    a[i] = a[j];
-    a[j] = tmp;
+    Policy::swap(a[i], a[j]);
     return;
 }
 
@@ -37,23 +46,23 @@ bool is_sorted(Value* a, const int n) {
 }
 
 // Implements insertion sort
-template <typename Value>
+template <typename Policy = DefaultSortPolicy, typename Value>
 void insertion_sort(Value* a, const int n) {
     for (auto i = 1; i < n; i++) {
-        for (auto j = i; j > 0 && less(a, j, j - 1); j--) {
-            swap(a, j, j - 1);
+        for (auto j = i; j > 0 && less<Policy>(a, j, j - 1); j--) {
+            swap<Policy>(a, j, j - 1);
         }
     }
     return;
 }
 
 // Implements bubble sort
-template <typename Value>
+template <typename Policy = DefaultSortPolicy, typename Value>
 void bubble_sort(Value* a, const int n) {
     for (auto i = 0; i < n; i++) {
         for (auto j = n-1; j > i; j--) {
-            if (less(a, j, j-1)) {
-                swap(a, j, j-1);
+            if (less<Policy>(a, j, j-1)) {
+                swap<Policy>(a, j, j-1);
             }
         }
     }
@@ -61,22 +70,22 @@ void bubble_sort(Value* a, const int n) {
 }
 
 // Implements selection sort
-template <typename Value>
+template <typename Policy = DefaultSortPolicy, typename Value>
 void selection_sort(Value* a, const int n) {
     for (auto i = 0; i < n; i++) {
         auto min = i;
         for (auto j = i+1; j < n; j++) {
-            if (less(a, j, min)) {
+            if (less<Policy>(a, j, min)) {
                 min = j;
             }
         }
-        swap(a, i, min);
+        swap<Policy>(a, i, min);
     }
     return;
 }
 
 // Implements shell sort
-template <typename Value>
+template <typename Policy = DefaultSortPolicy, typename Value>
 void shell_sort(Value* a, const int n) {
 
     // 3x+1 increment sequence:  1, 4, 13, 40, 121, 364, 1093, ...
@@ -88,8 +97,8 @@ void shell_sort(Value* a, const int n) {
     while (h >= 1) {
         // h-sort the array
         for (auto i = h; i < n; i++) {
-            for (auto j = i; j >= h && less(a, j, j-h); j -= h) {
-                swap(a, j, j-h);
+            for (auto j = i; j >= h && less<Policy>(a, j, j-h); j -= h) {
+                swap<Policy>(a, j, j-h);
             }
         }
         h /= 3;
@@ -98,67 +107,472 @@ void shell_sort(Value* a, const int n) {
 }
 
 // Implements merge sort
-template <typename Value>
+template <typename Policy = DefaultSortPolicy, typename Value>
 void merge(Value* a, Value* aux, const int lo, const int mid, const int hi) {
-    // copy to aux[]
+    // move to aux[]
     for (auto k = lo; k <= hi; k++) {
-        aux[k] = a[k];
+        Policy::move_aux(aux[k], a[k]);
     }
 
     // merge back to a[]
     auto i = lo, j = mid+1;
     for (auto k = lo; k <= hi; k++) {
         if (i > mid) {
-            a[k] = aux[j++];
+            Policy::move_aux(a[k], aux[j++]);
         } else if (j > hi) {
-            a[k] = aux[i++];
-        } else if (less(aux, j, i)) {
-            a[k] = aux[j++];
+            Policy::move_aux(a[k], aux[i++]);
+        } else if (less<Policy>(aux, j, i)) {
+            Policy::move_aux(a[k], aux[j++]);
         } else {
-            a[k] = aux[i++];
+            Policy::move_aux(a[k], aux[i++]);
         }
     }
     return;
 }
 
 // Implements the recursive merge sort
-template <typename Value>
+template <typename Policy = DefaultSortPolicy, typename Value>
 void merge_sort(Value* a, Value* aux, const int lo, const int hi) {
     if (hi <= lo) {
         return;
     }
     auto mid = lo + (hi - lo) / 2;
-    merge_sort(a, aux, lo, mid);
-    merge_sort(a, aux, mid+1, hi);
-    merge(a, aux, lo, mid, hi);
+    merge_sort<Policy>(a, aux, lo, mid);
+    merge_sort<Policy>(a, aux, mid+1, hi);
+    merge<Policy>(a, aux, lo, mid, hi);
     return;
 }
 
 // Implements the iterative merge sort
-template <typename Value>
+template <typename Policy = DefaultSortPolicy, typename Value>
 void bottom_up_merge_sort(Value* a, const int n) {
     Value* aux = new Value[n];
     for (auto sz = 1; sz < n; sz *= 2) {
         for (auto lo = 0; lo < n-sz; lo += sz+sz) {
-            merge(a, aux, lo, lo+sz-1, std::min(lo+sz+sz-1, n-1));
+            merge<Policy>(a, aux, lo, lo+sz-1, std::min(lo+sz+sz-1, n-1));
+        }
+    }
+    delete[] aux;
+    return;
+}
+
+// minimum number of values that one run must contribute in a row before the merges of natural merge
+// sort switch to galloping
+const int MIN_GALLOP = 7;
+
+// maximum number of pending runs of natural merge sort (the run lengths grow at least like the Fibonacci
+// numbers from the bottom of the stack, so this is plenty for any int n)
+const int MAX_PENDING_RUNS = 64;
+
+// Returns the minimum run length of natural merge sort for n values: n itself for n < 32, otherwise a value
+// in [16, 32] such that n / min_run is a power of two or slightly less than one
+inline int min_run_length(int n) {
+    auto r = 0;
+    while (n >= 32) {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return (n + r);
+}
+
+// Returns the length of the run that starts at a[lo] and ends at the latest at a[hi]; a strictly descending
+// run is reversed (strictly, so that reversing it keeps the sort stable)
+template <typename Policy = DefaultSortPolicy, typename Value>
+int count_run(Value* a, const int lo, const int hi) {
+    if (lo == hi) {
+        return (1);
+    }
+    auto end = lo + 1;
+    if (less<Policy>(a, end, lo)) {
+        while (end < hi && less<Policy>(a, end+1, end)) end++;
+        for (auto i = lo, j = end; i < j; i++, j--) {
+            swap<Policy>(a, i, j);
+        }
+    } else {
+        while (end < hi && !less<Policy>(a, end+1, end)) end++;
+    }
+    return (end - lo + 1);
+}
+
+// Implements binary insertion sort on a[lo..hi] given that a[lo..start-1] is already sorted; equal values
+// are inserted after each other to keep the sort stable
+template <typename Policy = DefaultSortPolicy, typename Value>
+void binary_insertion_sort(Value* a, const int lo, const int hi, int start) {
+    for (; start <= hi; start++) {
+        auto left = lo, right = start;
+        while (left < right) {
+            auto mid = left + (right - left) / 2;
+            if (less<Policy>(a, start, mid)) {
+                right = mid;
+            } else {
+                left = mid + 1;
+            }
+        }
+        Value v;
+        Policy::move(v, a[start]);
+        for (auto k = start; k > left; k--) {
+            Policy::move(a[k], a[k-1]);
+        }
+        Policy::move(a[left], v);
+    }
+    return;
+}
+
+// Returns the position at which key would be inserted into the sorted a[0..n-1]: after the equal values if
+// upper is set and before them otherwise. The position is found by an exponential search that starts at the
+// left end (or at the right end if from_right is set) followed by a binary search, so that it takes O(log d)
+// comparisons for a position at distance d from that end.
+template <typename Policy = DefaultSortPolicy, typename Value>
+int gallop(const Value& key, const Value* a, const int n, const bool upper, const bool from_right) {
+    // returns true if x goes before key
+    auto before = [&](const Value& x) { return (upper ? !Policy::less(key, x) : Policy::less(x, key)); };
+
+    int lo, hi;
+    auto last = 0, ofs = 1;
+    if (!from_right) {
+        while (ofs <= n && before(a[ofs-1])) {
+            last = ofs;
+            ofs *= 2;
+        }
+        lo = last;
+        hi = std::min(ofs - 1, n);
+    } else {
+        while (ofs <= n && !before(a[n-ofs])) {
+            last = ofs;
+            ofs *= 2;
+        }
+        lo = std::max(n - ofs + 1, 0);
+        hi = n - last;
+    }
+
+    while (lo < hi) {
+        auto mid = lo + (hi - lo) / 2;
+        if (before(a[mid])) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return (lo);
+}
+
+// Implements the merge of the runs a[lo..mid] and a[mid+1..hi] for a shorter left run: the left run is moved
+// to aux and merged from the front; once one run wins MIN_GALLOP times in a row, the merge gallops
+template <typename Policy = DefaultSortPolicy, typename Value>
+void merge_low(Value* a, Value* aux, const int lo, const int mid, const int hi, int& min_gallop) {
+    const int len = mid - lo + 1;
+    for (auto k = 0; k < len; k++) {
+        Policy::move_aux(aux[k], a[lo+k]);
+    }
+
+    auto i = 0, j = mid + 1, k = lo;  // next value of the left run in aux, of the right run in a, output
+    while (i < len && j <= hi) {
+        // one value at a time until one run wins often enough
+        auto wins_left = 0, wins_right = 0;
+        while (i < len && j <= hi && wins_left < min_gallop && wins_right < min_gallop) {
+            if (Policy::less(a[j], aux[i])) {
+                Policy::move(a[k++], a[j++]);
+                wins_right++;
+                wins_left = 0;
+            } else {
+                Policy::move_aux(a[k++], aux[i++]);
+                wins_left++;
+                wins_right = 0;
+            }
+        }
+
+        // gallop as long as it pays off
+        while (i < len && j <= hi) {
+            wins_left = gallop<Policy>(a[j], aux + i, len - i, true, false);
+            for (auto t = 0; t < wins_left; t++) Policy::move_aux(a[k++], aux[i++]);
+            if (i == len) break;
+            Policy::move(a[k++], a[j++]);
+            if (j > hi) break;
+
+            wins_right = gallop<Policy>(aux[i], a + j, hi - j + 1, false, false);
+            for (auto t = 0; t < wins_right; t++) Policy::move(a[k++], a[j++]);
+            if (j > hi) break;
+            Policy::move_aux(a[k++], aux[i++]);
+
+            min_gallop--;
+            if (wins_left < MIN_GALLOP && wins_right < MIN_GALLOP) break;
         }
+        min_gallop = std::max(min_gallop, 0) + 2;
+    }
+
+    // the rest of the right run is already in place
+    while (i < len) {
+        Policy::move_aux(a[k++], aux[i++]);
     }
+    return;
+}
+
+// Implements the merge of the runs a[lo..mid] and a[mid+1..hi] for a shorter right run: the right run is moved
+// to aux and merged from the back; once one run wins MIN_GALLOP times in a row, the merge gallops
+template <typename Policy = DefaultSortPolicy, typename Value>
+void merge_high(Value* a, Value* aux, const int lo, const int mid, const int hi, int& min_gallop) {
+    const int len = hi - mid;
+    for (auto k = 0; k < len; k++) {
+        Policy::move_aux(aux[k], a[mid+1+k]);
+    }
+
+    auto i = mid, j = len - 1, k = hi;  // last value of the left run in a, of the right run in aux, output
+    while (i >= lo && j >= 0) {
+        auto wins_left = 0, wins_right = 0;
+        while (i >= lo && j >= 0 && wins_left < min_gallop && wins_right < min_gallop) {
+            if (Policy::less(aux[j], a[i])) {
+                Policy::move(a[k--], a[i--]);
+                wins_left++;
+                wins_right = 0;
+            } else {
+                Policy::move_aux(a[k--], aux[j--]);
+                wins_right++;
+                wins_left = 0;
+            }
+        }
+
+        while (i >= lo && j >= 0) {
+            wins_left = (i - lo + 1) - gallop<Policy>(aux[j], a + lo, i - lo + 1, true, true);
+            for (auto t = 0; t < wins_left; t++) Policy::move(a[k--], a[i--]);
+            if (i < lo) break;
+            Policy::move_aux(a[k--], aux[j--]);
+            if (j < 0) break;
+
+            wins_right = (j + 1) - gallop<Policy>(a[i], aux, j + 1, false, true);
+            for (auto t = 0; t < wins_right; t++) Policy::move_aux(a[k--], aux[j--]);
+            if (j < 0) break;
+            Policy::move(a[k--], a[i--]);
+
+            min_gallop--;
+            if (wins_left < MIN_GALLOP && wins_right < MIN_GALLOP) break;
+        }
+        min_gallop = std::max(min_gallop, 0) + 2;
+    }
+
+    // the rest of the left run is already in place
+    while (j >= 0) {
+        Policy::move_aux(a[k--], aux[j--]);
+    }
+    return;
+}
+
+// Implements the merge of the pending runs r and r+1 of natural merge sort
+template <typename Policy = DefaultSortPolicy, typename Value>
+void merge_runs_at(Value* a, Value* aux, int* run_lo, int* run_len, int& runs, const int r, int& min_gallop) {
+    auto lo = run_lo[r];
+    auto mid = lo + run_len[r] - 1;
+    auto hi = mid + run_len[r+1];
+
+    run_len[r] += run_len[r+1];
+    if (r == runs - 3) {
+        run_lo[r+1] = run_lo[r+2];
+        run_len[r+1] = run_len[r+2];
+    }
+    runs--;
+
+    // the values of the left run that are not greater than the first value of the right run and the values
+    // of the right run that are not smaller than the last value of the left run are already in place
+    lo += gallop<Policy>(a[mid+1], a + lo, mid - lo + 1, true, false);
+    if (lo > mid) {
+        return;
+    }
+    hi = mid + gallop<Policy>(a[mid], a + mid + 1, hi - mid, false, true);
+    if (hi == mid) {
+        return;
+    }
+
+    if (mid - lo < hi - mid) {
+        merge_low<Policy>(a, aux, lo, mid, hi, min_gallop);
+    } else {
+        merge_high<Policy>(a, aux, lo, mid, hi, min_gallop);
+    }
+    return;
+}
+
+// Implements natural merge sort (Timsort): the input is split into ascending and strictly descending runs,
+// short runs are extended to a minimum length with binary insertion sort, and the runs are merged from a
+// stack whose lengths are kept balanced. The sort is stable and takes O(n) time on inputs that consist of a
+// few runs.
+template <typename Policy = DefaultSortPolicy, typename Value>
+void natural_merge_sort(Value* a, const int n) {
+    if (n < 2) {
+        return;
+    }
+    const auto min_run = min_run_length(n);
+    Value* aux = new Value[n / 2 + 1];
+    int run_lo[MAX_PENDING_RUNS], run_len[MAX_PENDING_RUNS];
+    auto runs = 0;
+    auto min_gallop = MIN_GALLOP;
+
+    for (auto lo = 0; lo < n; ) {
+        // find the next run and extend it to min_run values
+        auto len = count_run<Policy>(a, lo, n-1);
+        if (len < min_run) {
+            auto forced = std::min(min_run, n - lo);
+            binary_insertion_sort<Policy>(a, lo, lo + forced - 1, lo + len);
+            len = forced;
+        }
+        run_lo[runs] = lo;
+        run_len[runs] = len;
+        runs++;
+        lo += len;
+
+        // restore the invariants len[r-2] > len[r-1] + len[r] and len[r-1] > len[r] on the top of the stack
+        while (runs > 1) {
+            auto r = runs - 2;
+            if ((r > 0 && run_len[r-1] <= run_len[r] + run_len[r+1]) ||
+                (r > 1 && run_len[r-2] <= run_len[r-1] + run_len[r])) {
+                if (run_len[r-1] < run_len[r+1]) r--;
+            } else if (run_len[r] > run_len[r+1]) {
+                break;
+            }
+            merge_runs_at<Policy>(a, aux, run_lo, run_len, runs, r, min_gallop);
+        }
+    }
+
+    // merge the pending runs
+    while (runs > 1) {
+        auto r = runs - 2;
+        if (r > 0 && run_len[r-1] < run_len[r+1]) r--;
+        merge_runs_at<Policy>(a, aux, run_lo, run_len, runs, r, min_gallop);
+    }
+
+    delete[] aux;
+    return;
+}
+
+// number of runs that ping-pong merge sort merges at once (see merge_4way)
+const int MERGE_WAYS = 4;
+
+// size of subarrays that ping-pong merge sort hands over to binary insertion sort
+const int PING_PONG_RUN = 16;
+
+// Implements the 4-way merge of the runs src[lo..lo+width-1], src[lo+width..lo+2*width-1], ... (the last one
+// ending at src[hi], so there may be fewer than four) into dst[lo..hi]. While no run is empty, the smaller
+// heads of runs 0/1 and 2/3 are compared and the winner is taken without branching on the results: the
+// comparisons only select pointers, which the compiler turns into conditional moves. Once a run is empty,
+// the rest is merged with a plain scan over the heads. On ties the left run wins (stable).
+template <typename Policy = DefaultSortPolicy, typename Value>
+void merge_4way(Value* src, Value* dst, const int lo, const int hi, const int width) {
+    Value* head[MERGE_WAYS];
+    Value* end[MERGE_WAYS];
+    for (auto r = 0; r < MERGE_WAYS; r++) {
+        head[r] = src + std::min(lo + r*width, hi+1);
+        end[r] = src + std::min(lo + (r+1)*width, hi+1);
+    }
+    Value* out = dst + lo;
+    Value *p0 = head[0], *p1 = head[1], *p2 = head[2], *p3 = head[3];
+    bool take1, take3;  // whether run 1 beats run 0 and run 3 beats run 2
+
+    // takes the smallest of the four heads and returns true if it came from run 2 or 3
+    auto step = [&]() {
+        Value* w01 = take1 ? p1 : p0;
+        Value* w23 = take3 ? p3 : p2;
+        const bool right = Policy::less(*w23, *w01);
+        Policy::move_aux(*out++, *(right ? w23 : w01));
+        p0 += (!right & !take1);
+        p1 += (!right & take1);
+        p2 += (right & !take3);
+        p3 += (right & take3);
+        return (right);
+    };
+
+    // none of the runs can run empty within the next m steps if m is their minimum length
+    auto m = std::min(std::min(end[0] - p0, end[1] - p1), std::min(end[2] - p2, end[3] - p3));
+    while (m > 0) {
+        take1 = Policy::less(*p1, *p0);
+        take3 = Policy::less(*p3, *p2);
+        for (; m > 1; m--) {
+            const bool right = step();
+            if constexpr (std::is_arithmetic<Value>::value) {
+                // cheaper to compare both pairs again than to branch on right
+                take1 = Policy::less(*p1, *p0);
+                take3 = Policy::less(*p3, *p2);
+            } else if (right) {
+                take3 = Policy::less(*p3, *p2);
+            } else {
+                take1 = Policy::less(*p1, *p0);
+            }
+        }
+        // the heads may be past the end of their runs after the last step
+        step();
+        m = std::min(std::min(end[0] - p0, end[1] - p1), std::min(end[2] - p2, end[3] - p3));
+    }
+    head[0] = p0;
+    head[1] = p1;
+    head[2] = p2;
+    head[3] = p3;
+
+    // at least one run is empty now
+    while (true) {
+        auto best = -1;
+        for (auto r = 0; r < MERGE_WAYS; r++) {
+            if (head[r] != end[r] && (best < 0 || Policy::less(*head[r], *head[best]))) {
+                best = r;
+            }
+        }
+        if (best < 0) {
+            break;
+        }
+        Policy::move_aux(*out++, *head[best]++);
+    }
+    return;
+}
+
+// Implements the recursive ping-pong merge sort of a[lo..hi] into a[lo..hi] or, if into_aux is set, into
+// aux[lo..hi]: the quarters are sorted into the other array and then merged into the requested one, so the
+// two arrays swap roles on every level and nothing is ever copied back
+template <typename Policy = DefaultSortPolicy, typename Value>
+void ping_pong_merge_sort(Value* a, Value* aux, const int lo, const int hi, const bool into_aux) {
+    if (hi - lo < PING_PONG_RUN) {
+        binary_insertion_sort<Policy>(a, lo, hi, lo + 1);
+        if (into_aux) {
+            for (auto k = lo; k <= hi; k++) {
+                Policy::move_aux(aux[k], a[k]);
+            }
+        }
+        return;
+    }
+    auto width = (hi - lo + MERGE_WAYS) / MERGE_WAYS;
+    for (auto q = 0; q < MERGE_WAYS; q++) {
+        ping_pong_merge_sort<Policy>(a, aux, lo + q*width, std::min(lo + (q+1)*width - 1, hi), !into_aux);
+    }
+    if (into_aux) {
+        merge_4way<Policy>(a, aux, lo, hi, width);
+    } else {
+        merge_4way<Policy>(aux, a, lo, hi, width);
+    }
+    return;
+}
+
+// Implements ping-pong merge sort: a merge sort that alternates between the array and a single auxiliary
+// array from one level to the next instead of copying every range to aux before merging it back, and that
+// merges four runs per level with merge_4way. Every level reads and writes each value once, so the sort
+// moves each value about log4(n / PING_PONG_RUN) times (plus once more for half of the small subarrays)
+// against 2 log2(n) times for merge_sort. The recursion sorts each quarter completely before the next one,
+// so the lower levels work within the caches whatever their size (cache-oblivious). The sort is stable.
+template <typename Policy = DefaultSortPolicy, typename Value>
+void ping_pong_merge_sort(Value* a, const int n) {
+    if (n < 2) {
+        return;
+    }
+    Value* aux = new Value[n];
+    ping_pong_merge_sort<Policy>(a, aux, 0, n-1, false);
     delete[] aux;
     return;
 }
 
 // Implements the partition function of quick sort
-template <typename Value>
+template <typename Policy = DefaultSortPolicy, typename Value>
 int partition(Value* a, const int lo, const int hi) {
     auto i = lo, j = hi+1;
-    auto v = a[lo];
     while (true) {
-        while (less(a, ++i, lo)) {
+        while (less<Policy>(a, ++i, lo)) {
             if (i == hi) {
                 break;
             }
         }
-        while (less(a, lo, --j)) {
+        while (less<Policy>(a, lo, --j)) {
             if (j == lo) {
                 break;
             }
@@ -166,44 +580,807 @@ int partition(Value* a, const int lo, const int hi) {
         if (i >= j) {
             break;
         }
-        swap(a, i, j);
+        swap<Policy>(a, i, j);
     }
-    swap(a, lo, j);
+    swap<Policy>(a, lo, j);
     return j;
 }
 
 // Implements quick sort
-template <typename Value>
+template <typename Policy = DefaultSortPolicy, typename Value>
 void quick_sort(Value* a, const int lo, const int hi) {
     if (hi <= lo) {
         return;
     }
-    auto j = partition(a, lo, hi);
-    quick_sort(a, lo, j-1);
-    quick_sort(a, j+1, hi);
+    auto j = partition<Policy>(a, lo, hi);
+    quick_sort<Policy>(a, lo, j-1);
+    quick_sort<Policy>(a, j+1, hi);
     return;
 }
 
 // Implements 3-way quick sort
-template <typename Value>
+template <typename Policy = DefaultSortPolicy, typename Value>
 void quick_sort_3way(Value* a, const int lo, const int hi) {
     if (hi <= lo) {
         return;
     }
     auto lt = lo, i = lo+1, gt = hi;
     while (i <= gt) {
-        if (less(a, i, lt)) {
-            swap(a, lt++, i++);
-        } else if (less(a, lt, i)) {
-            swap(a, i, gt--);
+        if (less<Policy>(a, i, lt)) {
+            swap<Policy>(a, lt++, i++);
+        } else if (less<Policy>(a, lt, i)) {
+            swap<Policy>(a, i, gt--);
         } else {
             i++;
         }
     }
-    quick_sort_3way(a, lo, lt-1);
-    quick_sort_3way(a, gt+1, hi);
+    quick_sort_3way<Policy>(a, lo, lt-1);
+    quick_sort_3way<Policy>(a, gt+1, hi);
+    return;
+}
+
+// Implements the fast 3-way partition of Bentley and McIlroy of a[lo..hi] on the pivot a[lo]: keys equal
+// to the pivot are swapped to both ends while the scans run like in partition and are swapped into the
+// middle at the end, so keys that differ from the pivot are swapped only once. Sets lt and gt such that
+// a[lo..lt-1] < a[lt..gt] = pivot < a[gt+1..hi].
+template <typename Policy = DefaultSortPolicy, typename Value>
+void partition_3way(Value* a, const int lo, const int hi, int& lt, int& gt) {
+    auto i = lo, j = hi+1;
+    auto p = lo, q = hi+1;  // a[lo..p] and a[q..hi] are equal to the pivot
+    while (true) {
+        while (less<Policy>(a, ++i, lo)) {
+            if (i == hi) {
+                break;
+            }
+        }
+        while (less<Policy>(a, lo, --j)) {
+            if (j == lo) {
+                break;
+            }
+        }
+
+        // the scans met on a key equal to the pivot
+        if (i == j && !less<Policy>(a, i, lo)) {
+            swap<Policy>(a, ++p, i);
+        }
+        if (i >= j) {
+            break;
+        }
+
+        swap<Policy>(a, i, j);
+        if (!less<Policy>(a, i, lo) && !less<Policy>(a, lo, i)) {
+            swap<Policy>(a, ++p, i);
+        }
+        if (!less<Policy>(a, j, lo) && !less<Policy>(a, lo, j)) {
+            swap<Policy>(a, --q, j);
+        }
+    }
+
+    // swap the equal keys from both ends into the middle
+    i = j + 1;
+    for (auto k = lo; k <= p; k++) {
+        swap<Policy>(a, k, j--);
+    }
+    for (auto k = hi; k >= q; k--) {
+        swap<Policy>(a, k, i++);
+    }
+    lt = j + 1;
+    gt = i - 1;
+    return;
+}
+
+// Implements insertion sort on the subarray a[lo..hi]
+template <typename Policy = DefaultSortPolicy, typename Value>
+void insertion_sort(Value* a, const int lo, const int hi) {
+    for (auto i = lo + 1; i <= hi; i++) {
+        for (auto j = i; j > lo && less<Policy>(a, j, j - 1); j--) {
+            swap<Policy>(a, j, j - 1);
+        }
+    }
+    return;
+}
+
+// Returns the index of the median of a[i], a[j] and a[k]
+template <typename Policy = DefaultSortPolicy, typename Value>
+int median_of_3(const Value* a, const int i, const int j, const int k) {
+    if (less<Policy>(a, i, j)) {
+        return (less<Policy>(a, j, k) ? j : (less<Policy>(a, i, k) ? k : i));
+    }
+    return (less<Policy>(a, k, j) ? j : (less<Policy>(a, k, i) ? k : i));
+}
+
+// Returns the index of a pivot for a[lo..hi]: median-of-3 for small and Tukey's ninther for large ranges
+template <typename Policy = DefaultSortPolicy, typename Value>
+int choose_pivot(const Value* a, const int lo, const int hi) {
+    const int n = hi - lo + 1;
+    const int mid = lo + n / 2;
+    if (n <= 40) {
+        return (median_of_3<Policy>(a, lo, mid, hi));
+    }
+    const int eps = n / 8;
+    const int m1 = median_of_3<Policy>(a, lo, lo + eps, lo + eps + eps);
+    const int m2 = median_of_3<Policy>(a, mid - eps, mid, mid + eps);
+    const int m3 = median_of_3<Policy>(a, hi - eps - eps, hi - eps, hi);
+    return (median_of_3<Policy>(a, m1, m2, m3));
+}
+
+// size of subarrays that intro sort hands over to insertion sort
+const int INTRO_SORT_CUTOFF = 16;
+
+// Implements the introspective sort of a[lo..hi] with a bounded partitioning depth
+template <typename Policy = DefaultSortPolicy, typename Value>
+void intro_sort(Value* a, int lo, int hi, int depth_limit) {
+    while (hi - lo + 1 > INTRO_SORT_CUTOFF) {
+        // too many bad pivots: fall back to heap sort which is O(n log n) in the worst case
+        if (depth_limit == 0) {
+            heap_sort<Policy>(a + lo, hi - lo + 1);
+            return;
+        }
+        depth_limit--;
+
+        swap<Policy>(a, lo, choose_pivot<Policy>(a, lo, hi));
+        auto j = partition<Policy>(a, lo, hi);
+
+        // recurse on the smaller part and loop on the larger part to keep the stack at O(log n)
+        if (j - lo < hi - j) {
+            intro_sort<Policy>(a, lo, j-1, depth_limit);
+            lo = j+1;
+        } else {
+            intro_sort<Policy>(a, j+1, hi, depth_limit);
+            hi = j-1;
+        }
+    }
+    insertion_sort<Policy>(a, lo, hi);
+    return;
+}
+
+// size of subarrays that the vectorized intro sort hands over to a sorting network
+const int SIMD_SORT_CUTOFF = 64;
+
+// Implements the introspective sort of a[lo..hi] with the vectorized partition and sorting networks
+template <typename Value>
+void intro_sort_simd(Value* a, int lo, int hi, int depth_limit) {
+    while (hi - lo + 1 > SIMD_SORT_CUTOFF) {
+        if (depth_limit == 0) {
+            heap_sort(a + lo, hi - lo + 1);
+            return;
+        }
+        depth_limit--;
+
+        const Value pivot = a[choose_pivot(a, lo, hi)];
+        auto m = SimdSort<Value>::partition(a, lo, hi, pivot, false);
+
+        // no value is smaller than the pivot: split off the values equal to the pivot, they are in place
+        if (m == lo) {
+            lo = SimdSort<Value>::partition(a, lo, hi, pivot, true);
+            continue;
+        }
+
+        // recurse on the smaller part and loop on the larger part
+        if (m - lo < hi - m + 1) {
+            intro_sort_simd(a, lo, m-1, depth_limit);
+            lo = m;
+        } else {
+            intro_sort_simd(a, m, hi, depth_limit);
+            hi = m-1;
+        }
+    }
+    if (hi > lo) {
+        SimdSort<Value>::sort_network(a + lo, hi - lo + 1);
+    }
+    return;
+}
+
+// Returns the maximum partitioning depth of intro sort for n elements (2 log n)
+inline int intro_sort_depth(const int n) {
+    int depth_limit = 0;
+    for (auto m = n; m > 1; m /= 2) {
+        depth_limit += 2;
+    }
+    return (depth_limit);
+}
+
+// Implements intro sort: quick sort with median-of-3/ninther pivots, an insertion sort cutoff
+// and a heap sort fallback once the depth exceeds 2 log n; int, float and double arrays are
+// sorted with the vectorized kernels of simd_sort.h when the compiler targets AVX2 (unless the
+// operations go through a policy other than the default one)
+template <typename Policy = DefaultSortPolicy, typename Value>
+void intro_sort(Value* a, const int n) {
+    if constexpr (SimdSort<Value>::enabled && std::is_same<Policy, DefaultSortPolicy>::value) {
+        intro_sort_simd(a, 0, n-1, intro_sort_depth(n));
+    } else {
+        intro_sort<Policy>(a, 0, n-1, intro_sort_depth(n));
+    }
+    return;
+}
+
+// number of elements that the block partition classifies at once on each side
+const int PARTITION_BLOCK = 128;
+
+// Implements the block partition of BlockQuicksort (Edelkamp and Weiss) with the pivot in a[lo]: the
+// comparisons of a whole block are stored as offsets of the elements that have to be swapped, without
+// branching on their results, and the swaps are done afterwards in bulk
+template <typename Policy = DefaultSortPolicy, typename Value>
+int block_partition(Value* a, const int lo, const int hi) {
+    const Value& pivot = a[lo];
+    unsigned char offsets_l[PARTITION_BLOCK], offsets_r[PARTITION_BLOCK];
+    int num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+    int l = lo + 1, r = hi;  // a[lo+1..l-1] <= pivot <= a[r+1..hi]
+
+    while (r - l + 1 > 2 * PARTITION_BLOCK) {
+        // offsets of the elements of the left block that do not belong there (a[l+k] >= pivot)
+        if (num_l == 0) {
+            start_l = 0;
+            for (auto k = 0; k < PARTITION_BLOCK; k++) {
+                offsets_l[num_l] = k;
+                num_l += !Policy::less(a[l + k], pivot);
+            }
+        }
+        // offsets of the elements of the right block that do not belong there (a[r-k] <= pivot)
+        if (num_r == 0) {
+            start_r = 0;
+            for (auto k = 0; k < PARTITION_BLOCK; k++) {
+                offsets_r[num_r] = k;
+                num_r += !Policy::less(pivot, a[r - k]);
+            }
+        }
+
+        const int num = std::min(num_l, num_r);
+        for (auto k = 0; k < num; k++) {
+            swap<Policy>(a, l + offsets_l[start_l + k], r - offsets_r[start_r + k]);
+        }
+        num_l -= num;
+        num_r -= num;
+        start_l += num;
+        start_r += num;
+        if (num_l == 0) l += PARTITION_BLOCK;
+        if (num_r == 0) r -= PARTITION_BLOCK;
+    }
+
+    // partition the rest a[l..r] (including a block with unfinished swaps) with the classic scans
+    auto i = l - 1, j = r + 1;
+    while (true) {
+        while (++i <= r && less<Policy>(a, i, lo)) {}
+        while (--j >= l && less<Policy>(a, lo, j)) {}
+        if (i >= j) break;
+        swap<Policy>(a, i, j);
+    }
+    swap<Policy>(a, lo, j);
+    return (j);
+}
+
+// Implements the introspective sort of a[lo..hi] with the block partition
+template <typename Policy = DefaultSortPolicy, typename Value>
+void block_quick_sort(Value* a, int lo, int hi, int depth_limit) {
+    while (hi - lo + 1 > INTRO_SORT_CUTOFF) {
+        if (depth_limit == 0) {
+            heap_sort<Policy>(a + lo, hi - lo + 1);
+            return;
+        }
+        depth_limit--;
+
+        swap<Policy>(a, lo, choose_pivot<Policy>(a, lo, hi));
+        auto j = block_partition<Policy>(a, lo, hi);
+
+        if (j - lo < hi - j) {
+            block_quick_sort<Policy>(a, lo, j-1, depth_limit);
+            lo = j+1;
+        } else {
+            block_quick_sort<Policy>(a, j+1, hi, depth_limit);
+            hi = j-1;
+        }
+    }
+    insertion_sort<Policy>(a, lo, hi);
+    return;
+}
+
+// Implements BlockQuicksort: intro sort with the branch-free block partition, which avoids the branch
+// mispredictions of the scans in partition on random inputs
+template <typename Policy = DefaultSortPolicy, typename Value>
+void block_quick_sort(Value* a, const int n) {
+    block_quick_sort<Policy>(a, 0, n-1, intro_sort_depth(n));
+    return;
+}
+
+// select and median_of_medians call each other
+template <typename Policy = DefaultSortPolicy, typename Value>
+void select(Value* a, int lo, int hi, const int k, int depth_limit);
+
+// Returns the index of a pivot for a[lo..hi] that is guaranteed to split off at least 3/10 of the range on
+// either side: the median of the medians of groups of five, which are collected at the front of the range
+template <typename Policy = DefaultSortPolicy, typename Value>
+int median_of_medians(Value* a, const int lo, const int hi) {
+    auto m = lo;
+    for (auto i = lo; i <= hi; i += 5) {
+        auto group_hi = std::min(i + 4, hi);
+        insertion_sort<Policy>(a, i, group_hi);
+        swap<Policy>(a, m++, i + (group_hi - i) / 2);
+    }
+    auto mid = lo + (m - lo - 1) / 2;
+    select<Policy>(a, lo, m-1, mid, 0);
+    return (mid);
+}
+
+// Implements introselect on a[lo..hi]: rearranges the subarray such that a[k] holds the value that a sorted
+// subarray would hold there, with no larger values before and no smaller values after it. The pivots are
+// chosen like in intro sort until the depth limit is exceeded, then by the median of medians (which makes
+// the selection O(n) in the worst case).
+template <typename Policy, typename Value>
+void select(Value* a, int lo, int hi, const int k, int depth_limit) {
+    while (hi - lo + 1 > INTRO_SORT_CUTOFF) {
+        if (depth_limit > 0) {
+            depth_limit--;
+            swap<Policy>(a, lo, choose_pivot<Policy>(a, lo, hi));
+        } else {
+            swap<Policy>(a, lo, median_of_medians<Policy>(a, lo, hi));
+        }
+        auto j = partition<Policy>(a, lo, hi);
+        if (j == k) {
+            return;
+        } else if (j < k) {
+            lo = j+1;
+        } else {
+            hi = j-1;
+        }
+    }
+    insertion_sort<Policy>(a, lo, hi);
+    return;
+}
+
+// Returns the k-th smallest value of a (counting from 0) and rearranges a such that a[k] holds it, with
+// no larger values before and no smaller values after it
+template <typename Policy = DefaultSortPolicy, typename Value>
+Value select(Value* a, const int n, const int k) {
+    select<Policy>(a, 0, n-1, k, intro_sort_depth(n));
+    return (a[k]);
+}
+
+// largest k for which partial sort keeps the k smallest values in a heap instead of partitioning
+const int PARTIAL_SORT_HEAP_LIMIT = 1024;
+
+// Implements partial sort: rearranges a such that a[0..k-1] holds the k smallest values in sorted order
+// (the order of a[k..n-1] is unspecified). For small k, a max heap of the k smallest values seen so far is
+// kept in a[0..k-1] (with sink and swim from heap.h) and every other value only has to be compared with
+// its maximum; for larger k, a[0..k-1] is split off with select and sorted.
+template <typename Policy = DefaultSortPolicy, typename Value>
+void partial_sort(Value* a, const int n, int k) {
+    k = std::min(k, n);
+    if (k <= 0) {
+        return;
+    }
+    if (k > PARTIAL_SORT_HEAP_LIMIT) {
+        select<Policy>(a, 0, n-1, k-1, intro_sort_depth(n));
+        intro_sort<Policy>(a, k-1);
+        return;
+    }
+
+    // heap phase: a[0..k-1] is the max heap (with 1-based indices as in heap.h)
+    for (auto i = 2; i <= k; i++) {
+        swim<Policy>(a, i);
+    }
+    for (auto i = k; i < n; i++) {
+        if (less<Policy>(a, i, 0)) {
+            swap<Policy>(a, i, 0);
+            sink<Policy>(a, 1, k);
+        }
+    }
+
+    // sortdown phase of heap sort
+    for (auto i = k; i > 1; ) {
+        heap_swap<Policy>(a, 1, i--);
+        sink<Policy>(a, 1, i);
+    }
     return;
 }
 
+// Maps an integer key onto an unsigned integer with the same order by flipping the sign bit
+template <typename Key>
+typename std::make_unsigned<Key>::type radix_key(const Key key) {
+    using Unsigned = typename std::make_unsigned<Key>::type;
+    auto k = static_cast<Unsigned>(key);
+    if (std::is_signed<Key>::value) {
+        k ^= Unsigned(1) << (8 * sizeof(Key) - 1);
+    }
+    return (k);
+}
+
+// Maps a float key onto an unsigned integer with the same order (negative numbers have all bits flipped)
+inline uint32_t radix_key(const float key) {
+    uint32_t k;
+    memcpy(&k, &key, sizeof(k));
+    return ((k & 0x80000000u) ? ~k : k ^ 0x80000000u);
+}
+
+// Maps a double key onto an unsigned integer with the same order (negative numbers have all bits flipped)
+inline uint64_t radix_key(const double key) {
+    uint64_t k;
+    memcpy(&k, &key, sizeof(k));
+    return ((k & 0x8000000000000000ull) ? ~k : k ^ 0x8000000000000000ull);
+}
+
+// Implements the key extraction for arrays that are sorted by the values themselves
+struct IdentityKey {
+    template <typename Value>
+    const Value& operator()(const Value& v) const { return (v); }
+};
+
+// number of bits per digit of the LSD radix sort
+const int RADIX_BITS = 8;
+
+// Implements LSD radix sort on the (integer or floating-point) keys that key_of extracts from the values;
+// the passes alternate between the array and a single auxiliary array like in bottom-up merge sort
+template <typename Policy = DefaultSortPolicy, typename Value, typename KeyOf>
+void lsd_radix_sort(Value* a, const int n, KeyOf key_of) {
+    using Key = typename std::decay<decltype(radix_key(key_of(a[0])))>::type;
+    const int R = 1 << RADIX_BITS;
+    const int digits = (8 * sizeof(Key) + RADIX_BITS - 1) / RADIX_BITS;
+
+    if (n <= 1) {
+        return;
+    }
+
+    // count the frequencies of all digits in a single pass over the data
+    int* count = new int[digits * R]();
+    for (auto i = 0; i < n; i++) {
+        auto k = radix_key(key_of(a[i]));
+        for (auto d = 0; d < digits; d++) {
+            count[d * R + ((k >> (d * RADIX_BITS)) & (R - 1))]++;
+        }
+    }
+
+    Value* aux = new Value[n];
+    Value* src = a;
+    Value* dst = aux;
+    for (auto d = 0; d < digits; d++) {
+        int* c = count + d * R;
+
+        // skip the pass if all keys have the same digit
+        if (c[(radix_key(key_of(src[0])) >> (d * RADIX_BITS)) & (R - 1)] == n) {
+            continue;
+        }
+
+        // compute the start index of every digit
+        for (auto r = 0, sum = 0; r < R; r++) {
+            auto tmp = c[r];
+            c[r] = sum;
+            sum += tmp;
+        }
+
+        // distribute the values (stable)
+        for (auto i = 0; i < n; i++) {
+            Policy::move_aux(dst[c[(radix_key(key_of(src[i])) >> (d * RADIX_BITS)) & (R - 1)]++], src[i]);
+        }
+        std::swap(src, dst);
+    }
+
+    // move back if the last pass ended in the auxiliary array
+    if (src != a) {
+        for (auto i = 0; i < n; i++) {
+            Policy::move_aux(a[i], aux[i]);
+        }
+    }
+
+    delete[] aux;
+    delete[] count;
+    return;
+}
+
+// Implements LSD radix sort on an array of integer or floating-point values
+template <typename Policy = DefaultSortPolicy, typename Value>
+void lsd_radix_sort(Value* a, const int n) {
+    lsd_radix_sort<Policy>(a, n, IdentityKey());
+    return;
+}
+
+// Returns the d-th character of s or -1 if s has at most d characters
+inline int char_at(const std::string& s, const int d) {
+    return ((d < (int)s.length()) ? (unsigned char)s[d] : -1);
+}
+
+// Returns the length of the longest common prefix of s and t given that the first d characters are equal
+inline int lcp(const std::string& s, const std::string& t, int d) {
+    const int n = std::min(s.length(), t.length());
+    while (d < n && s[d] == t[d]) {
+        d++;
+    }
+    return (d);
+}
+
+// size of subarrays that the string sorts hand over to insertion sort
+const int STRING_SORT_CUTOFF = 15;
+
+// Implements insertion sort on a[lo..hi] for strings whose first d characters are equal
+template <typename Policy = DefaultSortPolicy>
+void insertion_sort_string(std::string* a, const int lo, const int hi, const int d) {
+    for (auto i = lo + 1; i <= hi; i++) {
+        for (auto j = i; j > lo && a[j].compare(d, std::string::npos, a[j - 1], d, std::string::npos) < 0; j--) {
+            swap<Policy>(a, j, j - 1);
+        }
+    }
+    return;
+}
+
+// Implements 3-way string quick sort (multikey quick sort) of a[lo..hi] for strings whose first d
+// characters are equal: partitions on the d-th character only and never re-scans common prefixes
+template <typename Policy = DefaultSortPolicy>
+void quick_sort_string(std::string* a, int lo, int hi, int d = 0) {
+    while (hi - lo + 1 > STRING_SORT_CUTOFF) {
+        // median-of-3 pivot character
+        const int mid = lo + (hi - lo) / 2;
+        const int c1 = char_at(a[lo], d), c2 = char_at(a[mid], d), c3 = char_at(a[hi], d);
+        const int m = (c1 < c2) ? ((c2 < c3) ? mid : ((c1 < c3) ? hi : lo)) : ((c3 < c2) ? mid : ((c3 < c1) ? hi : lo));
+        swap<Policy>(a, lo, m);
+
+        auto lt = lo, i = lo+1, gt = hi;
+        const int v = char_at(a[lo], d);
+        while (i <= gt) {
+            const int t = char_at(a[i], d);
+            if (t < v) {
+                swap<Policy>(a, lt++, i++);
+            } else if (t > v) {
+                swap<Policy>(a, i, gt--);
+            } else {
+                i++;
+            }
+        }
+
+        // a[lo..lt-1] < v = a[lt..gt] < a[gt+1..hi]
+        quick_sort_string<Policy>(a, lo, lt-1, d);
+        quick_sort_string<Policy>(a, gt+1, hi, d);
+
+        // continue with the next character of the middle part unless all its strings ended
+        if (v < 0) {
+            return;
+        }
+        if (lt == lo && gt == hi) {
+            // all strings share the d-th character: skip their whole common prefix in a single pass
+            auto h = (int)a[lo].length();
+            for (auto k = lo + 1; k <= hi && h > d + 1; k++) {
+                h = std::min(h, lcp(a[k], a[lo], d + 1));
+            }
+            d = h;
+        } else {
+            lo = lt;
+            hi = gt;
+            d++;
+        }
+    }
+    insertion_sort_string<Policy>(a, lo, hi, d);
+    return;
+}
+
+// Implements 3-way string quick sort of the array a with n strings
+template <typename Policy = DefaultSortPolicy>
+void quick_sort_string(std::string* a, const int n) {
+    quick_sort_string<Policy>(a, 0, n-1, 0);
+    return;
+}
+
+// Implements the LCP-aware merge of a[lo..mid] and a[mid+1..hi] where lcp[k] is the length of the longest
+// common prefix of a[k-1] and a[k] within each run; characters known to be equal are never compared again
+template <typename Policy = DefaultSortPolicy>
+void lcp_merge(std::string* a, std::string* aux, int* lcp_a, int* lcp_aux, const int lo, const int mid, const int hi) {
+    // move to aux[]
+    for (auto k = lo; k <= hi; k++) {
+        Policy::move_aux(aux[k], a[k]);
+        lcp_aux[k] = lcp_a[k];
+    }
+
+    // merge back to a[] where li and lj are the LCPs of aux[i] and aux[j] with the last string written
+    auto i = lo, j = mid+1;
+    auto li = 0, lj = 0;
+    for (auto k = lo; k <= hi; k++) {
+        bool take_i;
+        if (i > mid) {
+            take_i = false;
+        } else if (j > hi) {
+            take_i = true;
+        } else if (li != lj) {
+            // the string that shares more characters with the last string written is smaller
+            take_i = (li > lj);
+        } else {
+            const auto h = lcp(aux[i], aux[j], li);
+            take_i = (char_at(aux[i], h) <= char_at(aux[j], h));
+            if (take_i) {
+                lj = h;
+            } else {
+                li = h;
+            }
+        }
+
+        if (take_i) {
+            Policy::move_aux(a[k], aux[i]);
+            lcp_a[k] = li;
+            if (++i <= mid) li = lcp_aux[i];
+        } else {
+            Policy::move_aux(a[k], aux[j]);
+            lcp_a[k] = lj;
+            if (++j <= hi) lj = lcp_aux[j];
+        }
+    }
+    return;
+}
+
+// Implements the recursive LCP-aware merge sort of a[lo..hi] which also computes the LCP array
+template <typename Policy = DefaultSortPolicy>
+void merge_sort_string(std::string* a, std::string* aux, int* lcp_a, int* lcp_aux, const int lo, const int hi) {
+    if (hi <= lo) {
+        if (hi == lo) lcp_a[lo] = 0;
+        return;
+    }
+    auto mid = lo + (hi - lo) / 2;
+    merge_sort_string<Policy>(a, aux, lcp_a, lcp_aux, lo, mid);
+    merge_sort_string<Policy>(a, aux, lcp_a, lcp_aux, mid+1, hi);
+    lcp_merge<Policy>(a, aux, lcp_a, lcp_aux, lo, mid, hi);
+    return;
+}
+
+// Implements the LCP-aware merge sort of the array a with n strings (stable)
+template <typename Policy = DefaultSortPolicy>
+void merge_sort_string(std::string* a, const int n) {
+    std::string* aux = new std::string[n];
+    int* lcp_a = new int[n];
+    int* lcp_aux = new int[n];
+    merge_sort_string<Policy>(a, aux, lcp_a, lcp_aux, 0, n-1);
+    delete[] aux;
+    delete[] lcp_a;
+    delete[] lcp_aux;
+    return;
+}
+
+// Implements a stable merge sort of the indices idx[0..n-1] by the values a[idx[k]] (bottom-up with
+// insertion sort for short runs and alternating between the index array and a single auxiliary array)
+template <typename Policy = DefaultSortPolicy, typename Value>
+void merge_sort_indices(const Value* a, uint32_t* idx, const int n) {
+    const int run = 16;
+    for (auto lo = 0; lo < n; lo += run) {
+        for (auto i = lo + 1; i < std::min(lo + run, n); i++) {
+            const auto t = idx[i];
+            auto j = i;
+            for (; j > lo && Policy::less(a[t], a[idx[j - 1]]); j--) {
+                idx[j] = idx[j - 1];
+            }
+            idx[j] = t;
+        }
+    }
+
+    uint32_t* aux = new uint32_t[n];
+    uint32_t* src = idx;
+    uint32_t* dst = aux;
+    for (auto sz = run; sz < n; sz *= 2) {
+        for (auto lo = 0; lo < n; lo += sz+sz) {
+            const int mid = std::min(lo+sz, n), hi = std::min(lo+sz+sz, n);
+            auto i = lo, j = mid;
+            for (auto k = lo; k < hi; k++) {
+                if (i < mid && (j >= hi || !Policy::less(a[src[j]], a[src[i]]))) {
+                    dst[k] = src[i++];
+                } else {
+                    dst[k] = src[j++];
+                }
+            }
+        }
+        std::swap(src, dst);
+    }
+    if (src != idx) {
+        for (auto i = 0; i < n; i++) {
+            idx[i] = aux[i];
+        }
+    }
+    delete[] aux;
+    return;
+}
+
+// Rearranges a such that a[k] becomes the old a[idx[k]] by following the cycles of the permutation;
+// every value is moved exactly once (plus one extra move per cycle) and idx becomes the identity
+template <typename Policy = DefaultSortPolicy, typename Value>
+void apply_permutation(Value* a, uint32_t* idx, const int n) {
+    for (auto i = 0; i < n; i++) {
+        if (idx[i] == (uint32_t)i) {
+            continue;
+        }
+        Value tmp;
+        Policy::move(tmp, a[i]);
+        auto j = i;
+        while (idx[j] != (uint32_t)i) {
+            const auto k = idx[j];
+            Policy::move(a[j], a[k]);
+            idx[j] = j;
+            j = k;
+        }
+        Policy::move(a[j], tmp);
+        idx[j] = j;
+    }
+    return;
+}
+
+// Implements an indirect (sort-by-index) stable sort: sorts a 32-bit index array by the values and then
+// moves every value to its final position once, which pays off for values that are expensive to move
+template <typename Policy = DefaultSortPolicy, typename Value>
+void index_sort(Value* a, const int n) {
+    uint32_t* idx = new uint32_t[n];
+    for (auto i = 0; i < n; i++) {
+        idx[i] = i;
+    }
+    merge_sort_indices<Policy>(a, idx, n);
+    apply_permutation<Policy>(a, idx, n);
+    delete[] idx;
+    return;
+}
+
+// Returns the characters d..d+7 of s as a big-endian integer (padded with zero bytes), so that comparing the
+// integers of two strings compares the strings from their d-th up to their (d+7)-th character
+inline uint64_t string_prefix(const std::string& s, const int d) {
+    uint64_t prefix = 0;
+    const int length = std::min((int)s.length() - d, 8);
+    for (auto i = 0; i < length; i++) {
+        prefix |= (uint64_t)(unsigned char)s[d + i] << (56 - 8*i);
+    }
+    return (prefix);
+}
+
+// Implements the {key prefix, index} pairs of prefix_sort_string
+struct PrefixedIndex {
+    uint64_t prefix;
+    uint32_t index;
+};
+
+// size of groups of equal prefixes that prefix sort hands over to a sort with full string comparisons
+const int PREFIX_SORT_CUTOFF = 64;
+
+// Implements the prefix sort of the indices idx[0..n-1] of strings whose first d characters are equal: the
+// {prefix, index} pairs of the characters d..d+7 are sorted with LSD radix sort, which never touches the
+// strings themselves, and only groups of equal prefixes are looked at again (pairs is scratch space)
+template <typename Policy = DefaultSortPolicy>
+void prefix_sort_indices(const std::string* a, uint32_t* idx, PrefixedIndex* pairs, const int n, const int d) {
+    if (n < PREFIX_SORT_CUTOFF) {
+        merge_sort_indices<Policy>(a, idx, n);
+        return;
+    }
+    for (auto i = 0; i < n; i++) {
+        pairs[i] = PrefixedIndex{string_prefix(a[idx[i]], d), idx[i]};
+    }
+    lsd_radix_sort<Policy>(pairs, n, [](const PrefixedIndex& p) { return (p.prefix); });
+    for (auto i = 0; i < n; i++) {
+        idx[i] = pairs[i].index;
+    }
+
+    // strings with equal prefixes differ in their next characters if one of them is longer than d+8, and
+    // otherwise only if their lengths differ (a shorter string is padded with zero bytes)
+    for (auto lo = 0; lo < n; ) {
+        auto hi = lo + 1;
+        auto longer = (int)a[idx[lo]].length() > d + 8, lengths_differ = false;
+        while (hi < n && pairs[hi].prefix == pairs[lo].prefix) {
+            longer = longer || (int)a[idx[hi]].length() > d + 8;
+            lengths_differ = lengths_differ || a[idx[hi]].length() != a[idx[lo]].length();
+            hi++;
+        }
+        if (hi - lo > 1 && longer) {
+            prefix_sort_indices<Policy>(a, idx + lo, pairs + lo, hi - lo, d + 8);
+        } else if (hi - lo > 1 && lengths_differ) {
+            merge_sort_indices<Policy>(a, idx + lo, hi - lo);
+        }
+        lo = hi;
+    }
+    return;
+}
+
+// Implements a string sort with cached key prefixes: the first 8 characters of every string are packed into
+// an integer and the {prefix, index} pairs are sorted with LSD radix sort. Only groups of equal prefixes are
+// sorted again, by the next 8 characters (or by full string comparisons once they are small), and finally
+// the strings are moved to their positions once. The sort is stable and avoids the cache misses of string
+// comparisons, which chase a pointer to the characters of every string.
+template <typename Policy = DefaultSortPolicy>
+void prefix_sort_string(std::string* a, const int n) {
+    uint32_t* idx = new uint32_t[n];
+    for (auto i = 0; i < n; i++) {
+        idx[i] = i;
+    }
+    PrefixedIndex* pairs = new PrefixedIndex[n];
+    prefix_sort_indices<Policy>(a, idx, pairs, n, 0);
+    apply_permutation<Policy>(a, idx, n);
+    delete[] pairs;
+    delete[] idx;
+    return;
+}
 
 #endif
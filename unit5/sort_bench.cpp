@@ -0,0 +1,339 @@
+/******************************************************************************
+ *
+ * Benchmark harness that runs every sorting algorithm of sort.h and parallel_sort.h on
+ * generated inputs and prints the results as CSV (default) or JSON
+ *
+ * Every combination of algorithm, distribution and size is sorted in warmup + trials runs on
+ * copies of the same input; the median and the 95th percentile of the timed trials are
+ * reported. One more run with CountingSortPolicy (see sort_policy.h) gives the comparisons,
+ * swaps, single moves and moves to or from auxiliary arrays per element (the string sorts
+ * compare characters, which are not counted). The quadratic sorts only run on small inputs and the
+ * quick sorts that pick the first element as pivot only run on small sorted, reversed and
+ * sawtooth inputs.
+ *
+ *      % ./sort_bench --sizes 1000,100000 --trials 5 --warmup 1
+ *      algorithm,distribution,n,trials,median_ms,p95_ms,ns_per_element,comparisons_per_element,swaps_per_element,moves_per_element,aux_moves_per_element,sorted
+ *      selection_sort,uniform,1000,5,...
+ *      ...
+ *
+ *      % ./sort_bench --format json --algorithms intro_sort,natural_merge_sort --distributions zipfian
+ *      [
+ *        {"algorithm": "intro_sort", "distribution": "zipfian", "n": 1000, ...},
+ *        ...
+ *      ]
+ *
+ * Options:
+ *      --format csv|json          output format
+ *      --sizes n1,n2,...          input sizes (default 1000,10000,100000,1000000)
+ *      --trials t                 number of timed runs (default 5)
+ *      --warmup w                 number of untimed runs before them (default 1)
+ *      --algorithms a1,a2,...     algorithms to run (default all)
+ *      --distributions d1,d2,...  distributions to run (default all): uniform, sorted, reversed,
+ *                                 few-unique, zipfian, sawtooth, strings-p0, strings-p16, strings-p64
+ *                                 (random strings with a common prefix of 0, 16 or 64 characters)
+ *      --threads t                threads of the parallel sorts (default: all cores)
+ *
+ ******************************************************************************/
+
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "benchmark.h"
+#include "sort.h"
+#include "parallel_sort.h"
+
+using namespace std;
+
+// an algorithm together with the largest inputs it is run on
+struct Algorithm {
+    string name;
+    int max_n;            // for all distributions
+    int max_n_presorted;  // for sorted, reversed and sawtooth inputs
+};
+
+// sizes up to which the quadratic sorts are run
+const int QUADRATIC_MAX_N = 1 << 14;
+
+const Algorithm ALGORITHMS[] = {
+    {"selection_sort", QUADRATIC_MAX_N, QUADRATIC_MAX_N},
+    {"insertion_sort", QUADRATIC_MAX_N, QUADRATIC_MAX_N},
+    {"bubble_sort", QUADRATIC_MAX_N, QUADRATIC_MAX_N},
+    {"shell_sort", INT32_MAX, INT32_MAX},
+    {"merge_sort", INT32_MAX, INT32_MAX},
+    {"bottom_up_merge_sort", INT32_MAX, INT32_MAX},
+    {"natural_merge_sort", INT32_MAX, INT32_MAX},
+    {"ping_pong_merge_sort", INT32_MAX, INT32_MAX},
+    {"quick_sort", INT32_MAX, QUADRATIC_MAX_N},
+    {"quick_sort_3way", INT32_MAX, QUADRATIC_MAX_N},
+    {"intro_sort", INT32_MAX, INT32_MAX},
+    {"block_quick_sort", INT32_MAX, INT32_MAX},
+    {"heap_sort", INT32_MAX, INT32_MAX},
+    {"index_sort", INT32_MAX, INT32_MAX},
+    {"lsd_radix_sort", INT32_MAX, INT32_MAX},
+    {"quick_sort_string", INT32_MAX, INT32_MAX},
+    {"merge_sort_string", INT32_MAX, INT32_MAX},
+    {"prefix_sort_string", INT32_MAX, INT32_MAX},
+    {"parallel_merge_sort", INT32_MAX, INT32_MAX},
+    {"sample_sort", INT32_MAX, INT32_MAX},
+    {"parallel_quick_sort_3way", INT32_MAX, INT32_MAX},
+};
+
+// an input distribution: integer keys drawn from a Distribution or strings with a common prefix
+struct Input {
+    string name;
+    Distribution distribution;
+    int prefix_length;  // -1 for integer keys
+};
+
+const Input INPUTS[] = {
+    {"uniform", RANDOM, -1},      {"sorted", SORTED, -1},        {"reversed", REVERSED, -1},
+    {"few-unique", FEW_UNIQUE, -1}, {"zipfian", ZIPFIAN, -1},    {"sawtooth", SAWTOOTH, -1},
+    {"strings-p0", RANDOM, 0},    {"strings-p16", RANDOM, 16},   {"strings-p64", RANDOM, 64},
+};
+
+// the result of one algorithm on one input
+struct Result {
+    string algorithm, distribution;
+    int n, trials;
+    double median_ms, p95_ms;
+    double comparisons, swaps, moves, aux_moves;  // per element
+    bool sorted;
+};
+
+// Sorts a with the algorithm of the given name; returns false if the algorithm cannot sort values of this type
+template <typename Policy, typename Value>
+bool sort_with(const string& name, Value* a, const int n, const int threads) {
+    if (name == "selection_sort") {
+        selection_sort<Policy>(a, n);
+    } else if (name == "insertion_sort") {
+        insertion_sort<Policy>(a, n);
+    } else if (name == "bubble_sort") {
+        bubble_sort<Policy>(a, n);
+    } else if (name == "shell_sort") {
+        shell_sort<Policy>(a, n);
+    } else if (name == "merge_sort") {
+        Value* aux = new Value[n];
+        merge_sort<Policy>(a, aux, 0, n-1);
+        delete[] aux;
+    } else if (name == "bottom_up_merge_sort") {
+        bottom_up_merge_sort<Policy>(a, n);
+    } else if (name == "natural_merge_sort") {
+        natural_merge_sort<Policy>(a, n);
+    } else if (name == "ping_pong_merge_sort") {
+        ping_pong_merge_sort<Policy>(a, n);
+    } else if (name == "quick_sort") {
+        quick_sort<Policy>(a, 0, n-1);
+    } else if (name == "quick_sort_3way") {
+        quick_sort_3way<Policy>(a, 0, n-1);
+    } else if (name == "intro_sort") {
+        intro_sort<Policy>(a, n);
+    } else if (name == "block_quick_sort") {
+        block_quick_sort<Policy>(a, n);
+    } else if (name == "heap_sort") {
+        heap_sort<Policy>(a, n);
+    } else if (name == "index_sort") {
+        index_sort<Policy>(a, n);
+    } else if (name == "lsd_radix_sort") {
+        if constexpr (is_arithmetic<Value>::value) {
+            lsd_radix_sort<Policy>(a, n);
+        } else {
+            return (false);
+        }
+    } else if (name == "quick_sort_string" || name == "merge_sort_string" || name == "prefix_sort_string") {
+        if constexpr (is_same<Value, string>::value) {
+            if (name == "quick_sort_string") {
+                quick_sort_string<Policy>(a, n);
+            } else if (name == "merge_sort_string") {
+                merge_sort_string<Policy>(a, n);
+            } else {
+                prefix_sort_string<Policy>(a, n);
+            }
+        } else {
+            return (false);
+        }
+    } else if (name == "parallel_merge_sort") {
+        parallel_merge_sort<Policy>(a, n, threads);
+    } else if (name == "sample_sort") {
+        sample_sort<Policy>(a, n, threads);
+    } else if (name == "parallel_quick_sort_3way") {
+        parallel_quick_sort_3way<Policy>(a, n, threads);
+    } else {
+        return (false);
+    }
+    return (true);
+}
+
+// Returns the p-quantile (nearest rank) of the sorted times
+double quantile(const vector<double>& times, const double p) {
+    auto rank = (int)ceil(p * times.size());
+    return (times[max(rank, 1) - 1]);
+}
+
+// Runs one algorithm on the input; returns false if the algorithm cannot sort values of this type
+template <typename Value>
+bool measure(const Algorithm& algorithm, const Input& input_spec, const Value* input, const int n,
+             const int trials, const int warmup, const int threads, Result& result) {
+    vector<double> times;
+    auto sorted = true;
+    for (auto t = 0; t < warmup + trials; t++) {
+        bool supported = true;
+        auto run = time_sort(input, n, [&](Value* a, int n) {
+            supported = sort_with<DefaultSortPolicy>(algorithm.name, a, n, threads);
+        });
+        if (!supported) return (false);
+        sorted = sorted && run.sorted;
+        if (t >= warmup) times.push_back(run.ms);
+    }
+
+    // one more run that counts the element operations
+    Value* c = new Value[n];
+    for (auto i = 0; i < n; i++) c[i] = input[i];
+    CountingSortPolicy::reset();
+    sort_with<CountingSortPolicy>(algorithm.name, c, n, threads);
+    auto counts = CountingSortPolicy::counts();
+    delete[] c;
+
+    intro_sort(times.data(), times.size());
+    result = Result{algorithm.name, input_spec.name, n, trials, quantile(times, 0.5), quantile(times, 0.95),
+                    (double)counts.comparisons / n, (double)counts.swaps / n, (double)counts.moves / n,
+                    (double)counts.aux_moves / n, sorted};
+    return (true);
+}
+
+// prints one result as a CSV line or as a JSON object
+void print(const Result& r, const bool json, const bool first) {
+    auto count = [](const double x) {
+        ostringstream s;
+        s << fixed << setprecision(3) << x;
+        return (s.str());
+    };
+
+    cout << fixed << setprecision(4);
+    if (json) {
+        cout << (first ? "  " : ",\n  ") << "{\"algorithm\": \"" << r.algorithm << "\", \"distribution\": \""
+             << r.distribution << "\", \"n\": " << r.n << ", \"trials\": " << r.trials << ", \"median_ms\": "
+             << r.median_ms << ", \"p95_ms\": " << r.p95_ms << ", \"ns_per_element\": " << r.median_ms * 1e6 / r.n
+             << ", \"comparisons_per_element\": " << count(r.comparisons) << ", \"swaps_per_element\": "
+             << count(r.swaps) << ", \"moves_per_element\": " << count(r.moves) << ", \"aux_moves_per_element\": "
+             << count(r.aux_moves) << ", \"sorted\": " << (r.sorted ? "true" : "false") << "}";
+    } else {
+        cout << r.algorithm << "," << r.distribution << "," << r.n << "," << r.trials << "," << r.median_ms << ","
+             << r.p95_ms << "," << r.median_ms * 1e6 / r.n << "," << count(r.comparisons) << "," << count(r.swaps)
+             << "," << count(r.moves) << "," << count(r.aux_moves) << "," << (r.sorted ? "true" : "false") << endl;
+    }
+    return;
+}
+
+// splits a comma-separated list
+vector<string> split(const string& list) {
+    vector<string> items;
+    istringstream in(list);
+    string item;
+    while (getline(in, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return (items);
+}
+
+// returns true if the name is selected (an empty selection selects everything)
+bool selected(const vector<string>& selection, const string& name) {
+    if (selection.empty()) return (true);
+    for (auto& s : selection) {
+        if (s == name) return (true);
+    }
+    return (false);
+}
+
+// main entry point of the program
+int main(int argc, char* argv[]) {
+    auto json = false;
+    vector<int> sizes{1000, 10000, 100000, 1000000};
+    auto trials = 5, warmup = 1;
+    int threads = thread::hardware_concurrency();
+    vector<string> algorithms, distributions;
+
+    for (auto i = 1; i < argc; i++) {
+        string option = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "usage: " << argv[0] << " [--format csv|json] [--sizes n1,n2,...] [--trials t] [--warmup w]"
+                 << " [--algorithms a1,...] [--distributions d1,...] [--threads t]" << endl;
+            return (1);
+        }
+        string value = argv[++i];
+        if (option == "--format") {
+            json = (value == "json");
+        } else if (option == "--sizes") {
+            sizes.clear();
+            for (auto& s : split(value)) sizes.push_back((int)atof(s.c_str()));
+        } else if (option == "--trials") {
+            trials = max(1, atoi(value.c_str()));
+        } else if (option == "--warmup") {
+            warmup = max(0, atoi(value.c_str()));
+        } else if (option == "--algorithms") {
+            algorithms = split(value);
+        } else if (option == "--distributions") {
+            distributions = split(value);
+        } else if (option == "--threads") {
+            threads = max(1, atoi(value.c_str()));
+        } else {
+            cerr << "unknown option " << option << endl;
+            return (1);
+        }
+    }
+
+    if (json) {
+        cout << "[" << endl;
+    } else {
+        cout << "algorithm,distribution,n,trials,median_ms,p95_ms,ns_per_element,comparisons_per_element,"
+             << "swaps_per_element,moves_per_element,aux_moves_per_element,sorted" << endl;
+    }
+
+    auto first = true;
+    for (auto& input_spec : INPUTS) {
+        if (!selected(distributions, input_spec.name)) continue;
+        const bool presorted = (input_spec.prefix_length < 0) && (input_spec.distribution == SORTED ||
+                               input_spec.distribution == REVERSED || input_spec.distribution == SAWTOOTH);
+
+        for (auto n : sizes) {
+            if (n < 1) continue;
+            int* ints = nullptr;
+            string* strings = nullptr;
+            if (input_spec.prefix_length < 0) {
+                ints = new int[n];
+                fill(ints, n, input_spec.distribution);
+            } else {
+                strings = new string[n];
+                fill_strings(strings, n, input_spec.prefix_length);
+            }
+
+            for (auto& algorithm : ALGORITHMS) {
+                if (!selected(algorithms, algorithm.name)) continue;
+                if (n > (presorted ? algorithm.max_n_presorted : algorithm.max_n)) continue;
+
+                Result result;
+                auto supported = (ints != nullptr)
+                                     ? measure(algorithm, input_spec, ints, n, trials, warmup, threads, result)
+                                     : measure(algorithm, input_spec, strings, n, trials, warmup, threads, result);
+                if (supported) {
+                    print(result, json, first);
+                    first = false;
+                }
+            }
+
+            delete[] ints;
+            delete[] strings;
+        }
+    }
+
+    if (json) {
+        cout << endl << "]" << endl;
+    }
+    return (0);
+}
@@ -0,0 +1,103 @@
+/******************************************************************************
+ *
+ * Policies for the element operations of the sorting algorithms in sort.h, heap.h and
+ * parallel_sort.h
+ *
+ * Every algorithm takes a policy as its first template parameter and does all comparisons,
+ * swaps and moves of values through it. DefaultSortPolicy does them directly, so all of its
+ * functions are inlined away. CountingSortPolicy counts them, which gives a cost model of an
+ * algorithm on an input besides its running time:
+ *
+ *      intro_sort(a, n);                        // DefaultSortPolicy
+ *      CountingSortPolicy::reset();
+ *      intro_sort<CountingSortPolicy>(a, n);
+ *      auto counts = CountingSortPolicy::counts();
+ *
+ ******************************************************************************/
+
+#ifndef __SORT_POLICY_H__
+#define __SORT_POLICY_H__
+
+#include <atomic>
+#include <utility>
+
+// Implements the element operations without any instrumentation
+struct DefaultSortPolicy {
+    // returns true if v is smaller than w
+    template <typename Value>
+    static bool less(const Value& v, const Value& w) { return (v < w); }
+
+    // swaps v and w (by moving, so that no copies are made)
+    template <typename Value>
+    static void swap(Value& v, Value& w) {
+        Value tmp = std::move(v);
+        v = std::move(w);
+        w = std::move(tmp);
+        return;
+    }
+
+    // moves src to dst within the array (or to or from a single temporary)
+    template <typename Value>
+    static void move(Value& dst, Value& src) { dst = std::move(src); }
+
+    // moves src to dst where one of them is in an auxiliary array
+    template <typename Value>
+    static void move_aux(Value& dst, Value& src) { dst = std::move(src); }
+};
+
+// the counts of the element operations of CountingSortPolicy
+struct SortCounts {
+    long long comparisons;
+    long long swaps;
+    long long moves;      // single moves within the array or to or from a temporary
+    long long aux_moves;  // moves to or from an auxiliary array
+};
+
+// Implements the element operations with counters (atomic, so that the parallel sorts can use it as well)
+struct CountingSortPolicy {
+    static inline std::atomic<long long> comparisons{0};
+    static inline std::atomic<long long> swaps{0};
+    static inline std::atomic<long long> moves{0};
+    static inline std::atomic<long long> aux_moves{0};
+
+    // resets all counters to 0
+    static void reset() {
+        comparisons = 0;
+        swaps = 0;
+        moves = 0;
+        aux_moves = 0;
+        return;
+    }
+
+    // returns the current counts
+    static SortCounts counts() { return (SortCounts{comparisons, swaps, moves, aux_moves}); }
+
+    template <typename Value>
+    static bool less(const Value& v, const Value& w) {
+        comparisons.fetch_add(1, std::memory_order_relaxed);
+        return (DefaultSortPolicy::less(v, w));
+    }
+
+    template <typename Value>
+    static void swap(Value& v, Value& w) {
+        swaps.fetch_add(1, std::memory_order_relaxed);
+        DefaultSortPolicy::swap(v, w);
+        return;
+    }
+
+    template <typename Value>
+    static void move(Value& dst, Value& src) {
+        moves.fetch_add(1, std::memory_order_relaxed);
+        DefaultSortPolicy::move(dst, src);
+        return;
+    }
+
+    template <typename Value>
+    static void move_aux(Value& dst, Value& src) {
+        aux_moves.fetch_add(1, std::memory_order_relaxed);
+        DefaultSortPolicy::move_aux(dst, src);
+        return;
+    }
+};
+
+#endif
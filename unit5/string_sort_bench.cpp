@@ -0,0 +1,78 @@
+/******************************************************************************
+ *
+ * Compares the character-indexed string sorts with the comparison sorts on the words from
+ * standard input, scaled up to n strings that share a common prefix of the given length
+ * (like the lines of a log file)
+ *
+ *      % ./string_sort_bench 1000000 24 < ../data/tale.txt
+ *      n = 1000000, common prefix = 24
+ *      quick_sort          ... ms
+ *      quick_sort_3way     ... ms
+ *      merge_sort          ... ms
+ *      quick_sort_string   ... ms
+ *      merge_sort_string   ... ms
+ *      prefix_sort_string  ... ms
+ *
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "sort.h"
+
+using namespace std;
+
+// times one sorting algorithm on a copy of the input and checks the result
+template <typename Sort>
+void run(const string& name, const vector<string>& input, Sort sort_function) {
+    auto result = time_sort(input.data(), input.size(), sort_function);
+    cout << setw(20) << left << name << right << setw(10) << fixed << setprecision(2) << result.ms << " ms";
+    if (!result.sorted) {
+        cout << " (not sorted!)";
+    }
+    cout << endl;
+    return;
+}
+
+// main entry point of the program
+int main(int argc, char* argv[]) {
+    int n = (argc >= 2) ? atoi(argv[1]) : 1000000;
+    int prefix_length = (argc >= 3) ? atoi(argv[2]) : 24;
+
+    // read the words from standard input
+    vector<string> words;
+    string word;
+    while (cin >> word) {
+        words.push_back(word);
+    }
+    if (words.empty()) {
+        cerr << "no words on standard input" << endl;
+        return (1);
+    }
+
+    // scale up to n strings: four prefixes that differ only in the last character, then the word
+    vector<string> input(n);
+    for (auto i = 0; i < n; i++) {
+        string prefix(prefix_length, '-');
+        if (prefix_length > 0) prefix[prefix_length - 1] = 'a' + i % 4;
+        input[i] = prefix + words[i % words.size()];
+    }
+
+    cout << "n = " << n << ", common prefix = " << prefix_length << endl;
+    run("quick_sort", input, [](string* a, int n) { quick_sort(a, 0, n-1); });
+    run("quick_sort_3way", input, [](string* a, int n) { quick_sort_3way(a, 0, n-1); });
+    run("merge_sort", input, [](string* a, int n) {
+        string* aux = new string[n];
+        merge_sort(a, aux, 0, n-1);
+        delete[] aux;
+    });
+    run("quick_sort_string", input, [](string* a, int n) { quick_sort_string(a, n); });
+    run("merge_sort_string", input, [](string* a, int n) { merge_sort_string(a, n); });
+    run("prefix_sort_string", input, [](string* a, int n) { prefix_sort_string(a, n); });
+
+    return (0);
+}
@@ -0,0 +1,172 @@
+/******************************************************************************
+ *
+ * A work-stealing thread pool for fork-join parallelism
+ *
+ * Every thread owns a double-ended queue of tasks. A thread pushes the tasks it spawns to
+ * the back of its own queue and also takes its next task from the back (so it keeps working
+ * on the most recent, cache-hot subproblem). Idle threads steal from the front of the queue
+ * of another thread, which holds the oldest and therefore largest subproblems.
+ *
+ * The thread that creates the pool is worker 0: it does not get a thread of its own but
+ * executes tasks while it waits for a task group to finish.
+ *
+ ******************************************************************************/
+
+#ifndef __THREAD_POOL_H__
+#define __THREAD_POOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Implements a counter of the pending tasks of one fork-join step
+class TaskGroup {
+    friend class ThreadPool;
+    std::atomic<int> pending;  // number of spawned tasks that have not finished yet
+
+   public:
+    // default constructor
+    TaskGroup() : pending(0) {}
+};
+
+// Implements a pool of threads that execute tasks and steal tasks from each other
+class ThreadPool {
+    // a task together with the group that waits for it
+    struct Task {
+        std::function<void()> run;
+        TaskGroup* group;
+    };
+
+    // a task queue that is owned by one thread
+    struct WorkQueue {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<WorkQueue> queues;      // one task queue per worker
+    std::vector<std::thread> workers;   // the worker threads 1..n-1
+    std::atomic<int> queued;            // number of tasks in all queues
+    std::atomic<bool> stop;             // set when the pool is destroyed
+    std::mutex idle_lock;               // protects sleeping on idle
+    std::condition_variable idle;       // idle workers sleep on this
+
+    // the pool and the worker index of the calling thread
+    static inline thread_local const ThreadPool* current_pool = nullptr;
+    static inline thread_local int current_id = 0;
+
+    // returns the index of the calling thread in this pool (0 for threads that do not belong to the pool)
+    int worker_id() const {
+        return ((current_pool == this) ? current_id : 0);
+    }
+
+    // takes the newest task of the own queue or steals the oldest task of another queue
+    bool take(const int id, Task& task) {
+        {
+            std::lock_guard<std::mutex> guard(queues[id].lock);
+            if (!queues[id].tasks.empty()) {
+                task = std::move(queues[id].tasks.back());
+                queues[id].tasks.pop_back();
+                queued--;
+                return (true);
+            }
+        }
+        const int n = queues.size();
+        for (auto k = 1; k < n; k++) {
+            auto& victim = queues[(id + k) % n];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                queued--;
+                return (true);
+            }
+        }
+        return (false);
+    }
+
+    // runs a task and signals its group
+    void execute(Task& task) {
+        task.run();
+        task.group->pending--;
+        return;
+    }
+
+    // the main loop of a worker thread
+    void work(const int id) {
+        current_pool = this;
+        current_id = id;
+        while (!stop) {
+            Task task;
+            if (take(id, task)) {
+                execute(task);
+            } else {
+                std::unique_lock<std::mutex> guard(idle_lock);
+                idle.wait(guard, [this]() { return (stop || queued > 0); });
+            }
+        }
+        return;
+    }
+
+   public:
+    // constructor with the total number of threads (including the calling thread)
+    ThreadPool(const int threads) : queues(threads < 1 ? 1 : threads), queued(0), stop(false) {
+        for (auto i = 1; i < (int)queues.size(); i++) {
+            workers.emplace_back([this, i]() { work(i); });
+        }
+    }
+
+    // the pool can neither be copied nor moved because the workers point to it
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // destructor
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(idle_lock);
+            stop = true;
+        }
+        idle.notify_all();
+        for (auto& w : workers) {
+            w.join();
+        }
+    }
+
+    // returns the number of threads in the pool
+    int size() const { return (queues.size()); }
+
+    // spawns a new task that belongs to the task group g
+    void spawn(TaskGroup& g, std::function<void()> f) {
+        g.pending++;
+        auto& queue = queues[worker_id()];
+        {
+            std::lock_guard<std::mutex> guard(queue.lock);
+            queue.tasks.push_back(Task{std::move(f), &g});
+            queued++;
+        }
+        {
+            std::lock_guard<std::mutex> guard(idle_lock);
+        }
+        idle.notify_one();
+        return;
+    }
+
+    // waits until all tasks of the group g are finished and executes other tasks meanwhile
+    void wait(TaskGroup& g) {
+        const int id = worker_id();
+        while (g.pending > 0) {
+            Task task;
+            if (take(id, task)) {
+                execute(task);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        return;
+    }
+};
+
+#endif
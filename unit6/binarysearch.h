@@ -1,18 +1,36 @@
 #ifndef __BINARY_SEARCH_H__
 #define __BINARY_SEARCH_H__
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "learned_index.h"
+#include "simd_search.h"
 #include "st.h"
 
 // Implements the class for a symbol table based on binary search
 template <typename Key, typename Value>
-class BinarySearchST : public ST<Key, Value> {
+class BinarySearchST {
     const int initial_capacity = 2;  // initial capacity of the key/values array
 
+    const int prefetch_levels = 4;   // number of levels that the frozen search prefetches ahead
+    const int default_error = 32;    // default maximum error of the learned index
+
     Key* keys;    // array for the keys
     Value* vals;  // array for the values
     int n;        // number of key-value pairs
     int length;   // length of the keys and values array
 
+    Key* eytzinger_keys;  // the keys in Eytzinger (BFS) order, 1-based, while the table is frozen
+    int* eytzinger_rank;  // the position in keys of every key in eytzinger_keys
+
+    PiecewiseLinearModel<Key> model;  // the learned index of the keys while the table is learned
+
     // copys the array of keys and values as well as the length
     void deep_copy_keys_and_values(const Key* new_keys, const Value* new_vals, const int new_length) {
         length = new_length;
@@ -27,11 +45,36 @@ class BinarySearchST : public ST<Key, Value> {
 
     // frees the arrays of key value pairs
     void free_arrays() {
+        thaw();
         delete[] keys;
         delete[] vals;
         return;
     }
 
+    // stores keys[i..] in-order into the subtree of node k of the Eytzinger layout; returns the next i
+    int build_eytzinger(int i, const int k) {
+        if (k <= n) {
+            i = build_eytzinger(i, 2*k);
+            eytzinger_keys[k] = keys[i];
+            eytzinger_rank[k] = i++;
+            i = build_eytzinger(i, 2*k + 1);
+        }
+        return (i);
+    }
+
+    // returns the number of keys strictly less than key by descending the Eytzinger layout without branches
+    int frozen_rank(const Key& key) const {
+        int k = 1;
+        while (k <= n) {
+            // the descendants prefetch_levels levels below k are adjacent, starting at k * 2^prefetch_levels
+            __builtin_prefetch(eytzinger_keys + ((long long)k << prefetch_levels));
+            k = 2*k + (eytzinger_keys[k] < key);
+        }
+        // k went right after the last node whose key is not less than key; strip these steps and that one
+        k >>= __builtin_ffs(~k);
+        return ((k == 0) ? n : eytzinger_rank[k]);
+    }
+
     // resize the underlying arrays
     void resize(const int new_length) {
         // allocate temporary array
@@ -53,22 +96,48 @@ class BinarySearchST : public ST<Key, Value> {
         return;
     }    
 
+    // inserts a new key-value pair at position i
+    void insert(const int i, const Key& key, const Value& val) {
+        thaw();
+        model.clear();
+        if (n == length) resize(2*length);
+
+        for (int j = n; j > i; j--)  {
+            keys[j] = keys[j-1];
+            vals[j] = vals[j-1];
+        }
+        keys[i] = key;
+        vals[i] = val;
+        n++;
+        return;
+    }
+
    public:
     // default constructor
-    BinarySearchST() : n(0), length(initial_capacity) { 
+    BinarySearchST() : n(0), length(initial_capacity), eytzinger_keys(nullptr), eytzinger_rank(nullptr) { 
         keys = new Key[length];
         vals = new Value[length];
     }
 
+    // constructor that builds the table from count key-value pairs in any order in O(n log n)
+    BinarySearchST(const Key* new_keys, const Value* new_vals, const int count) : BinarySearchST() {
+        put_batch(new_keys, new_vals, count);
+    }
+
     // copy constructor
-    BinarySearchST(const BinarySearchST& st) : n(st.n) { 
+    BinarySearchST(const BinarySearchST& st) : n(st.n), eytzinger_keys(nullptr), eytzinger_rank(nullptr), model(st.model) { 
         deep_copy_keys_and_values(st.keys, st.vals, st.length); 
+        if (st.is_frozen()) freeze();
     }
 
     // move constructor
-    BinarySearchST(BinarySearchST&& st) : n(st.n), keys(st.keys), vals(st.vals), length(st.length) {
+    BinarySearchST(BinarySearchST&& st) : n(st.n), keys(st.keys), vals(st.vals), length(st.length),
+                                          eytzinger_keys(st.eytzinger_keys), eytzinger_rank(st.eytzinger_rank),
+                                          model(std::move(st.model)) {
         st.keys = nullptr;
         st.vals = nullptr;
+        st.eytzinger_keys = nullptr;
+        st.eytzinger_rank = nullptr;
         st.length = 0;
         st.n = 0;
     }
@@ -80,6 +149,8 @@ class BinarySearchST : public ST<Key, Value> {
         // copy the keys and values
         deep_copy_keys_and_values(st.keys, st.vals, st.length);
         n = st.n;
+        if (st.is_frozen()) freeze();
+        model = st.model;
         return (*this);
     }
 
@@ -92,8 +163,13 @@ class BinarySearchST : public ST<Key, Value> {
         vals = st.vals;
         length = st.length;
         n = st.n;
+        eytzinger_keys = st.eytzinger_keys;
+        eytzinger_rank = st.eytzinger_rank;
+        model = std::move(st.model);
         st.keys = nullptr;
         st.vals = nullptr;
+        st.eytzinger_keys = nullptr;
+        st.eytzinger_rank = nullptr;
         st.length = 0;
         st.n = 0;
         return (*this);
@@ -115,16 +191,57 @@ class BinarySearchST : public ST<Key, Value> {
         }
 
         // insert new key-value pair
-        if (n == length) resize(2*length);
+        insert(i, key, val);
+        return;
+    }
 
-        for (int j = n; j > i; j--)  {
-            keys[j] = keys[j-1];
-            vals[j] = vals[j-1];
+    // puts count key-value pairs into the table at once (a later pair wins over an earlier one with the same
+    // key): the pairs are sorted and merged with the table in a single pass into arrays that are resized
+    // only once, which takes O(n + count log count) instead of O(n) per pair
+    void put_batch(const Key* new_keys, const Value* new_vals, const int count) {
+        if (count <= 0) return;
+
+        // sort the pairs by key (stable, so that the last pair of equal keys comes last)
+        int* order = new int[count];
+        for (int j = 0; j < count; j++) order[j] = j;
+        std::stable_sort(order, order + count, [&](int x, int y) { return (new_keys[x] < new_keys[y]); });
+
+        // allocate arrays that are large enough for all keys
+        int new_length = (length > initial_capacity) ? length : initial_capacity;
+        while (new_length < n + count) new_length *= 2;
+        auto tmp_keys = new Key[new_length];
+        auto tmp_vals = new Value[new_length];
+
+        // merge the keys of the table with the sorted pairs
+        int i = 0, j = 0, k = 0;
+        while (i < n || j < count) {
+            // only the last of the pairs with equal keys counts
+            while (j + 1 < count && !(new_keys[order[j]] < new_keys[order[j+1]])) j++;
+
+            if (j == count || (i < n && keys[i] < new_keys[order[j]])) {
+                tmp_keys[k] = keys[i];
+                tmp_vals[k++] = vals[i++];
+            } else {
+                // the pair replaces the value of a key that is already in the table
+                if (i < n && keys[i] == new_keys[order[j]]) i++;
+                tmp_keys[k] = new_keys[order[j]];
+                tmp_vals[k++] = new_vals[order[j++]];
+            }
         }
-        keys[i] = key;
-        vals[i] = val;
-        n++;
-        
+        delete[] order;
+
+        // free existing arrays and assign the merged arrays
+        free_arrays();
+        keys = tmp_keys;
+        vals = tmp_vals;
+        length = new_length;
+        n = k;
+
+        // a learned index is rebuilt once for the whole batch
+        if constexpr (std::is_arithmetic<Key>::value) {
+            if (is_learned()) learn(model.max_error());
+        }
+
         return;
     }
 
@@ -140,6 +257,13 @@ class BinarySearchST : public ST<Key, Value> {
         return (nullptr);
     }
 
+    // gets the value for a given key to update in place, putting the key with val first if it is new
+    Value& get_or_insert(const Key& key, const Value& val) {
+        int i = rank(key);
+        if (i == n || keys[i] != key) insert(i, key, val);
+        return (vals[i]);
+    }
+
     // removes a key from the table
     void remove(const Key& key) {
         // if array is empty, nothing can be removed
@@ -150,6 +274,8 @@ class BinarySearchST : public ST<Key, Value> {
         if (i == n || keys[i] != key) 
             return;
         // otherwise copy the values over
+        thaw();
+        model.clear();
         for (int j = i; j < n-1; j++)  {
             keys[j] = keys[j+1];
             vals[j] = vals[j+1];
@@ -162,8 +288,66 @@ class BinarySearchST : public ST<Key, Value> {
         return;
     }
 
+    // rebuilds the keys into a read-optimized copy in Eytzinger layout that rank (and thus get and contains)
+    // searches from then on; the table stays frozen until put inserts or remove deletes a key
+    void freeze() {
+        thaw();
+        eytzinger_keys = new Key[n + 1];
+        eytzinger_rank = new int[n + 1];
+        build_eytzinger(0, 1);
+        return;
+    }
+
+    // drops the Eytzinger layout of a frozen table
+    void thaw() {
+        delete[] eytzinger_keys;
+        delete[] eytzinger_rank;
+        eytzinger_keys = nullptr;
+        eytzinger_rank = nullptr;
+        return;
+    }
+
+    // checks if the table is frozen
+    bool is_frozen() const { return (eytzinger_keys != nullptr); }
+
+    // fits a learned index (a piecewise linear model, see learned_index.h) to the numeric keys, which
+    // predicts the position of a key within error positions, so that rank only searches that window from
+    // then on; put_batch rebuilds the index, while put inserting or remove deleting a key drops it
+    void learn(const int error) {
+        model.build(keys, n, error);
+        return;
+    }
+
+    // fits a learned index with the default error
+    void learn() {
+        learn(default_error);
+        return;
+    }
+
+    // drops the learned index
+    void forget() {
+        model.clear();
+        return;
+    }
+
+    // checks if the table has a learned index
+    bool is_learned() const { return (model.is_built()); }
+
     // returns the number of keys in this symbol table strictly less than key
     int rank(const Key& key) const {
+        if constexpr (std::is_arithmetic<Key>::value) {
+            if (is_learned())
+                return (model.rank(keys, n, key));
+        }
+        if (is_frozen())
+            return (frozen_rank(key));
+        if constexpr (SimdRank<Key>::enabled)
+            return (SimdRank<Key>::rank(keys, n, key));
+        return (binary_rank(key));
+    }
+
+    // returns the number of keys strictly less than key by the classic binary search
+    int binary_rank(const Key& key) const {
         int lo = 0, hi = n - 1;
         while (lo <= hi) {
             int mid = lo + (hi - lo) / 2;
@@ -187,6 +371,547 @@ class BinarySearchST : public ST<Key, Value> {
 
     // number of key-value pairs in the table
     int size() const { return (n); }
+
+    // calls visit(key, value) for all key-value pairs in order of the keys
+    template <typename Visit>
+    void for_each(Visit visit) const {
+        for (auto i = 0; i < n; i++) {
+            visit(keys[i], vals[i]);
+        }
+        return;
+    }
+};
+
+// Implements the class for a symbol table based on binary search with string keys: the characters of all
+// keys are stored back to back in sorted order in a single arena (key i is arena[offsets[i]..offsets[i+1]-1])
+// and the first four characters of every key are kept as an integer in a separate array, so that most
+// comparisons of a search never touch the arena. Only the values in use are constructed. The frozen mode
+// lays out the prefixes (and the positions of the keys) in Eytzinger order, and the learned index is fitted
+// to the prefixes, as these are the numeric part of the keys.
+template <typename Value>
+class BinarySearchST<std::string, Value> {
+    const int initial_capacity = 2;  // initial capacity of the key/values array
+
+    const int prefetch_levels = 4;   // number of levels that the frozen search prefetches ahead
+    const int default_error = 32;    // default maximum error of the learned index
+
+    char* arena;          // the characters of all keys in sorted order
+    int arena_length;     // length of the arena
+    int* offsets;         // start of every key in the arena; offsets[n] is the end of the last key
+    uint32_t* prefixes;   // first four characters of every key (big-endian, padded with zero bytes)
+    Value* vals;          // array for the values (only vals[0..n-1] are constructed)
+    int n;                // number of key-value pairs
+    int length;           // length of the prefixes and values array (offsets has one more entry)
+
+    uint32_t* eytzinger_prefixes;  // the prefixes in Eytzinger (BFS) order, 1-based, while frozen
+    int* eytzinger_rank;           // the position of the key of every prefix in eytzinger_prefixes
+
+    PiecewiseLinearModel<uint32_t> model;  // the learned index of the prefixes while the table is learned
+
+    // returns the first four characters of a key as a big-endian integer (padded with zero bytes)
+    static uint32_t key_prefix(const std::string_view key) {
+        uint32_t prefix = 0;
+        const int len = (key.length() < 4) ? key.length() : 4;
+        for (auto i = 0; i < len; i++) {
+            prefix |= (uint32_t)(unsigned char)key[i] << (24 - 8*i);
+        }
+        return (prefix);
+    }
+
+    // compares key (with the given prefix) to the i-th key of the table like std::string::compare
+    int compare(const std::string_view key, const uint32_t prefix, const int i) const {
+        if (prefix != prefixes[i])
+            return ((prefix < prefixes[i]) ? -1 : 1);
+        return (key.compare(std::string_view(arena + offsets[i], offsets[i+1] - offsets[i])));
+    }
+
+    // allocates the arrays for the given lengths without constructing any values
+    void allocate_arrays(const int new_length, const int new_arena_length) {
+        length = new_length;
+        arena_length = new_arena_length;
+        arena = new char[arena_length];
+        offsets = new int[length + 1];
+        prefixes = new uint32_t[length];
+        vals = static_cast<Value*>(::operator new(sizeof(Value) * length));
+        return;
+    }
+
+    // copys the arrays of another table with the same length
+    void deep_copy(const BinarySearchST& st) {
+        allocate_arrays(st.length, st.arena_length);
+        n = st.n;
+        memcpy(arena, st.arena, st.offsets[n]);
+        memcpy(offsets, st.offsets, sizeof(int) * (n + 1));
+        memcpy(prefixes, st.prefixes, sizeof(uint32_t) * n);
+        for (auto i = 0; i < n; i++) {
+            new (vals + i) Value(st.vals[i]);
+        }
+        return;
+    }
+
+    // frees the arrays and destroys the values
+    void free_arrays() {
+        thaw();
+        for (auto i = 0; i < n; i++) {
+            vals[i].~Value();
+        }
+        ::operator delete(vals);
+        delete[] arena;
+        delete[] offsets;
+        delete[] prefixes;
+        return;
+    }
+
+    // stores the prefixes from i on in-order into the subtree of node k of the Eytzinger layout; returns the
+    // next i
+    int build_eytzinger(int i, const int k) {
+        if (k <= n) {
+            i = build_eytzinger(i, 2*k);
+            eytzinger_prefixes[k] = prefixes[i];
+            eytzinger_rank[k] = i++;
+            i = build_eytzinger(i, 2*k + 1);
+        }
+        return (i);
+    }
+
+    // returns the number of keys strictly less than key by descending the Eytzinger layout; the arena is only
+    // read for the nodes whose prefix equals that of key
+    int frozen_rank(const std::string_view key, const uint32_t prefix) const {
+        int k = 1;
+        while (k <= n) {
+            // the descendants prefetch_levels levels below k are adjacent, starting at k * 2^prefetch_levels
+            __builtin_prefetch(eytzinger_prefixes + ((long long)k << prefetch_levels));
+            const uint32_t p = eytzinger_prefixes[k];
+            k = 2*k + (p < prefix || (p == prefix && compare(key, prefix, eytzinger_rank[k]) > 0));
+        }
+        // k went right after the last node whose key is not less than key; strip these steps and that one
+        k >>= __builtin_ffs(~k);
+        return ((k == 0) ? n : eytzinger_rank[k]);
+    }
+
+    // returns the number of keys strictly less than key with the learned index: it finds the first key with
+    // the prefix of key, from which a galloping search (steps of 1, 2, 4, ...) covers the keys with the same
+    // prefix, so that a key that is the first with its prefix takes a single comparison
+    int learned_rank(const std::string_view key, const uint32_t prefix) const {
+        int lo = model.rank(prefixes, n, prefix);
+        int step = 1;
+        while (lo + step <= n && compare(key, prefix, lo + step - 1) > 0) {
+            lo += step;
+            step *= 2;
+        }
+        int hi = (lo + step - 1 < n) ? lo + step - 1 : n;
+        while (lo < hi) {
+            int mid = lo + (hi - lo) / 2;
+            if (compare(key, prefix, mid) > 0)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return (lo);
+    }
+
+    // resize the underlying arrays (but not the arena)
+    void resize(const int new_length) {
+        auto tmp_offsets = new int[new_length + 1];
+        auto tmp_prefixes = new uint32_t[new_length];
+        auto tmp_vals = static_cast<Value*>(::operator new(sizeof(Value) * new_length));
+
+        // move the offsets, prefixes and values
+        memcpy(tmp_offsets, offsets, sizeof(int) * (n + 1));
+        memcpy(tmp_prefixes, prefixes, sizeof(uint32_t) * n);
+        for (auto i = 0; i < n; i++) {
+            new (tmp_vals + i) Value(std::move(vals[i]));
+            vals[i].~Value();
+        }
+
+        // free existing arrays and assign the temporary arrays to the new arrays
+        ::operator delete(vals);
+        delete[] offsets;
+        delete[] prefixes;
+        offsets = tmp_offsets;
+        prefixes = tmp_prefixes;
+        vals = tmp_vals;
+        length = new_length;
+
+        return;
+    }
+
+    // resize the arena
+    void resize_arena(const int new_arena_length) {
+        auto tmp_arena = new char[new_arena_length];
+        memcpy(tmp_arena, arena, offsets[n]);
+        delete[] arena;
+        arena = tmp_arena;
+        arena_length = new_arena_length;
+        return;
+    }
+
+    // inserts a new key-value pair with the given prefix at position i
+    void insert(const int i, const std::string_view key, const uint32_t prefix, const Value& val) {
+        thaw();
+        model.clear();
+
+        // make room for the key in the arrays and in the arena
+        if (n == length) resize(2*length);
+        const int len = key.length();
+        if (offsets[n] + len > arena_length) {
+            auto new_arena_length = 2*arena_length;
+            while (offsets[n] + len > new_arena_length) new_arena_length *= 2;
+            resize_arena(new_arena_length);
+        }
+
+        // insert the characters of the key and shift the later keys and values
+        memmove(arena + offsets[i] + len, arena + offsets[i], offsets[n] - offsets[i]);
+        memcpy(arena + offsets[i], key.data(), len);
+        for (int j = n + 1; j > i; j--) {
+            offsets[j] = offsets[j-1] + len;
+        }
+        for (int j = n; j > i; j--) {
+            prefixes[j] = prefixes[j-1];
+        }
+        prefixes[i] = prefix;
+        if (i == n) {
+            new (vals + n) Value(val);
+        } else {
+            new (vals + n) Value(std::move(vals[n-1]));
+            for (int j = n - 1; j > i; j--) {
+                vals[j] = std::move(vals[j-1]);
+            }
+            vals[i] = val;
+        }
+        n++;
+        return;
+    }
+
+   public:
+    // default constructor
+    BinarySearchST() : n(0), eytzinger_prefixes(nullptr), eytzinger_rank(nullptr) {
+        allocate_arrays(initial_capacity, 8 * initial_capacity);
+        offsets[0] = 0;
+    }
+
+    // constructor that builds the table from count key-value pairs in any order in O(n log n)
+    BinarySearchST(const std::string* new_keys, const Value* new_vals, const int count) : BinarySearchST() {
+        put_batch(new_keys, new_vals, count);
+    }
+
+    // copy constructor
+    BinarySearchST(const BinarySearchST& st)
+        : eytzinger_prefixes(nullptr), eytzinger_rank(nullptr), model(st.model) {
+        deep_copy(st);
+        if (st.is_frozen()) freeze();
+    }
+
+    // move constructor
+    BinarySearchST(BinarySearchST&& st)
+        : arena(st.arena), arena_length(st.arena_length), offsets(st.offsets), prefixes(st.prefixes),
+          vals(st.vals), n(st.n), length(st.length), eytzinger_prefixes(st.eytzinger_prefixes),
+          eytzinger_rank(st.eytzinger_rank), model(std::move(st.model)) {
+        st.eytzinger_prefixes = nullptr;
+        st.eytzinger_rank = nullptr;
+        st.arena = nullptr;
+        st.offsets = nullptr;
+        st.prefixes = nullptr;
+        st.vals = nullptr;
+        st.arena_length = 0;
+        st.length = 0;
+        st.n = 0;
+    }
+
+    // copy assignment
+    BinarySearchST& operator=(const BinarySearchST& st) {
+        // free the existing arrays
+        free_arrays();
+        // copy the keys and values
+        deep_copy(st);
+        if (st.is_frozen()) freeze();
+        model = st.model;
+        return (*this);
+    }
+
+    // move assignment
+    BinarySearchST& operator=(BinarySearchST&& st) {
+        // free the existing arrays
+        free_arrays();
+
+        arena = st.arena;
+        arena_length = st.arena_length;
+        offsets = st.offsets;
+        prefixes = st.prefixes;
+        vals = st.vals;
+        length = st.length;
+        n = st.n;
+        eytzinger_prefixes = st.eytzinger_prefixes;
+        eytzinger_rank = st.eytzinger_rank;
+        model = std::move(st.model);
+        st.eytzinger_prefixes = nullptr;
+        st.eytzinger_rank = nullptr;
+        st.arena = nullptr;
+        st.offsets = nullptr;
+        st.prefixes = nullptr;
+        st.vals = nullptr;
+        st.arena_length = 0;
+        st.length = 0;
+        st.n = 0;
+        return (*this);
+    }
+
+    // destructor
+    ~BinarySearchST() {
+        free_arrays();
+    }
+
+    // put a key-value pair into the table
+    void put(const std::string_view key, const Value& val) {
+        const auto prefix = key_prefix(key);
+        int i = rank(key);
+
+        // key is already in table
+        if (i < n && compare(key, prefix, i) == 0) {
+            vals[i] = val;
+            return;
+        }
+
+        // insert new key-value pair
+        insert(i, key, prefix, val);
+        return;
+    }
+
+    // puts count key-value pairs into the table at once (a later pair wins over an earlier one with the same
+    // key): the pairs are sorted and merged with the table in a single pass into arrays that are resized
+    // only once, which takes O(n + count log count) instead of O(n) per pair
+    template <typename Key>
+    void put_batch(const Key* new_keys, const Value* new_vals, const int count) {
+        if (count <= 0) return;
+
+        // sort the pairs by key (stable, so that the last pair of equal keys comes last)
+        int* order = new int[count];
+        long long batch_chars = 0;
+        for (int j = 0; j < count; j++) {
+            order[j] = j;
+            batch_chars += new_keys[j].length();
+        }
+        std::stable_sort(order, order + count, [&](int x, int y) { return (new_keys[x] < new_keys[y]); });
+
+        // allocate arrays that are large enough for all keys
+        int new_length = (length > initial_capacity) ? length : initial_capacity;
+        while (new_length < n + count) new_length *= 2;
+        int new_arena_length = (arena_length > 8 * initial_capacity) ? arena_length : 8 * initial_capacity;
+        while (new_arena_length < offsets[n] + batch_chars) new_arena_length *= 2;
+        BinarySearchST merged;
+        merged.free_arrays();
+        merged.allocate_arrays(new_length, new_arena_length);
+        merged.offsets[0] = 0;
+
+        // appends a key-value pair to the merged table
+        auto append = [&](const char* chars, const int len, const uint32_t prefix, const Value& val) {
+            memcpy(merged.arena + merged.offsets[merged.n], chars, len);
+            merged.offsets[merged.n + 1] = merged.offsets[merged.n] + len;
+            merged.prefixes[merged.n] = prefix;
+            new (merged.vals + merged.n) Value(val);
+            merged.n++;
+        };
+
+        // merge the keys of the table with the sorted pairs
+        int i = 0, j = 0;
+        while (i < n || j < count) {
+            // only the last of the pairs with equal keys counts
+            while (j + 1 < count && !(new_keys[order[j]] < new_keys[order[j+1]])) j++;
+
+            const int c = (j == count) ? -1 : (i == n) ? 1 : -compare(new_keys[order[j]], key_prefix(new_keys[order[j]]), i);
+            if (c < 0) {
+                append(arena + offsets[i], offsets[i+1] - offsets[i], prefixes[i], vals[i]);
+                i++;
+            } else {
+                // the pair replaces the value of a key that is already in the table
+                if (c == 0) i++;
+                const auto& key = new_keys[order[j]];
+                append(key.data(), key.length(), key_prefix(key), new_vals[order[j++]]);
+            }
+        }
+        delete[] order;
+
+        // a learned index is rebuilt once for the whole batch
+        const bool learned = is_learned();
+        const int error = model.max_error();
+        *this = std::move(merged);
+        if (learned) learn(error);
+        return;
+    }
+
+    // gets a value for a given key
+    const Value* get(const std::string_view key) const {
+        if (is_empty())
+            return (nullptr);
+
+        int i = rank(key);
+
+        if (i < n && compare(key, key_prefix(key), i) == 0)
+            return (&(vals[i]));
+        return (nullptr);
+    }
+
+    // gets the value for a given key to update in place, putting the key with val first if it is new
+    Value& get_or_insert(const std::string_view key, const Value& val) {
+        const auto prefix = key_prefix(key);
+        int i = rank(key);
+        if (i == n || compare(key, prefix, i) != 0) insert(i, key, prefix, val);
+        return (vals[i]);
+    }
+
+    // removes a key from the table
+    void remove(const std::string_view key) {
+        // if array is empty, nothing can be removed
+        if (is_empty()) return;
+
+        int i = rank(key);
+        // do nothing if the key is not contained
+        if (i == n || compare(key, key_prefix(key), i) != 0)
+            return;
+
+        // otherwise remove the characters of the key and shift the later keys and values
+        thaw();
+        model.clear();
+        const int len = offsets[i+1] - offsets[i];
+        memmove(arena + offsets[i], arena + offsets[i+1], offsets[n] - offsets[i+1]);
+        for (int j = i + 1; j < n; j++) {
+            offsets[j] = offsets[j+1] - len;
+        }
+        for (int j = i; j < n-1; j++) {
+            prefixes[j] = prefixes[j+1];
+            vals[j] = std::move(vals[j+1]);
+        }
+        vals[n-1].~Value();
+        n--;
+
+        // resize if 1/4 full
+        if (n > 0 && n == length/4) resize(length/2);
+        if (arena_length > 8 * initial_capacity && offsets[n] < arena_length/4) resize_arena(arena_length/2);
+
+        return;
+    }
+
+    // rebuilds the prefixes into a read-optimized copy in Eytzinger layout that rank (and thus get and
+    // contains) searches from then on; the table stays frozen until put inserts or remove deletes a key
+    void freeze() {
+        thaw();
+        eytzinger_prefixes = new uint32_t[n + 1];
+        eytzinger_rank = new int[n + 1];
+        build_eytzinger(0, 1);
+        return;
+    }
+
+    // drops the Eytzinger layout of a frozen table
+    void thaw() {
+        delete[] eytzinger_prefixes;
+        delete[] eytzinger_rank;
+        eytzinger_prefixes = nullptr;
+        eytzinger_rank = nullptr;
+        return;
+    }
+
+    // checks if the table is frozen
+    bool is_frozen() const { return (eytzinger_prefixes != nullptr); }
+
+    // fits a learned index (see learned_index.h) to the prefixes, which predicts the first key with the
+    // prefix of a key within error positions; put_batch rebuilds the index, while put inserting or remove
+    // deleting a key drops it. Keys that share their first four characters are still found by binary search.
+    void learn(const int error) {
+        model.build(prefixes, n, error);
+        return;
+    }
+
+    // fits a learned index with the default error
+    void learn() {
+        learn(default_error);
+        return;
+    }
+
+    // drops the learned index
+    void forget() {
+        model.clear();
+        return;
+    }
+
+    // checks if the table has a learned index
+    bool is_learned() const { return (model.is_built()); }
+
+    // returns the number of keys in this symbol table strictly less than key
+    int rank(const std::string_view key) const {
+        if (is_learned())
+            return (learned_rank(key, key_prefix(key)));
+        if (is_frozen())
+            return (frozen_rank(key, key_prefix(key)));
+        return (binary_rank(key));
+    }
+
+    // returns the number of keys strictly less than key by binary search over the prefixes (and the arena
+    // for keys with equal prefixes)
+    int binary_rank(const std::string_view key) const {
+        const auto prefix = key_prefix(key);
+        int lo = 0, hi = n - 1;
+        while (lo <= hi) {
+            int mid = lo + (hi - lo) / 2;
+            const int c = compare(key, prefix, mid);
+            if (c < 0)
+                hi = mid - 1;
+            else if (c > 0)
+                lo = mid + 1;
+            else
+                return mid;
+        }
+        return lo;
+    }
+
+    // checks if there is a value paired with a key
+    bool contains(const std::string_view key) const {
+        return (get(key) != nullptr);
+    }
+
+    // checks if the symbol table is empty
+    bool is_empty() const { return (n == 0); }
+
+    // number of key-value pairs in the table
+    int size() const { return (n); }
+
+    // calls visit(key, value) for all key-value pairs in order of the keys
+    template <typename Visit>
+    void for_each(Visit visit) const {
+        for_each_as<std::string>(visit);
+        return;
+    }
+
+   protected:
+    // calls visit(key, value) for all key-value pairs in order of the keys, passing the keys as Key
+    template <typename Key, typename Visit>
+    void for_each_as(Visit visit) const {
+        for (auto i = 0; i < n; i++) {
+            visit(Key(arena + offsets[i], offsets[i+1] - offsets[i]), vals[i]);
+        }
+        return;
+    }
+};
+
+// Implements the class for a symbol table based on binary search with string_view keys as the table for
+// string keys, whose arena holds a copy of the characters of every key, so that the keys need not outlive
+// the table; for_each visits views into the arena, which stay valid until the table changes
+template <typename Value>
+class BinarySearchST<std::string_view, Value> : public BinarySearchST<std::string, Value> {
+   public:
+    // default constructor
+    BinarySearchST() {}
+
+    // constructor that builds the table from count key-value pairs in any order in O(n log n)
+    BinarySearchST(const std::string_view* new_keys, const Value* new_vals, const int count) {
+        this->put_batch(new_keys, new_vals, count);
+    }
+
+    // calls visit(key, value) for all key-value pairs in order of the keys
+    template <typename Visit>
+    void for_each(Visit visit) const {
+        this->template for_each_as<std::string_view>(visit);
+        return;
+    }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,86 @@
+/*
+    ./dispatch_bench ../data/tale.txt 100
+
+compares the throughput of the frequency count (freq_counter.h) of all words of
+a text repeated 100 times with direct calls to the symbol table classes and with
+virtual calls through ST (an STAdapter of the class); the sequential search is
+left out, as its searches take thousands of probes per word
+
+table               direct      virtual
+binary_search   ... MB/s     ... MB/s
+fibonacci_search ...
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "binarysearch.h"
+#include "fibsearch.h"
+#include "freq_counter.h"
+#include "st.h"
+
+using namespace std;
+
+// counts the words of the text into the table and returns the throughput in MB/s
+template <typename Table>
+double mb_per_s(Table& st, const string& text, FreqCount& result) {
+    auto start = chrono::steady_clock::now();
+    result = freq_count(st, text.data(), text.size(), 1);
+    auto stop = chrono::steady_clock::now();
+    return (text.size() / chrono::duration<double, micro>(stop - start).count());
+}
+
+// runs the frequency count with direct and with virtual calls to a table class (the best of two runs each,
+// taken in turns so that neither profits from memory that the other has freed)
+template <typename Table>
+void benchmark(const string& name, const string& text) {
+    FreqCount direct_result, virtual_result;
+    double direct = 0, virtual_calls = 0;
+
+    for (auto round = 0; round < 2; round++) {
+        Table* table = new Table();
+        direct = max(direct, mb_per_s(*table, text, direct_result));
+        delete table;
+
+        ST<string_view, int>* st = new STAdapter<string_view, int, Table>();
+        virtual_calls = max(virtual_calls, mb_per_s(*st, text, virtual_result));
+        delete st;
+    }
+
+    cout << setw(17) << left << name << right << fixed << setprecision(1) << setw(7) << direct << " MB/s"
+         << setw(8) << virtual_calls << " MB/s";
+    if (direct_result.max_str != virtual_result.max_str || direct_result.max_cnt != virtual_result.max_cnt ||
+        direct_result.distinct != virtual_result.distinct || direct_result.words != virtual_result.words) {
+        cout << " (counts differ!)";
+    }
+    cout << endl;
+    return;
+}
+
+// main entry point of the program
+int main(int argc, char* argv[]) {
+    string file = (argc >= 2) ? argv[1] : "../data/tale.txt";
+    int times = (argc >= 3) ? atoi(argv[2]) : 100;
+
+    // the text repeated times times
+    ifstream in(file);
+    stringstream contents;
+    contents << in.rdbuf();
+    string text;
+    text.reserve(contents.str().size() * times);
+    for (auto i = 0; i < times; i++) text += contents.str();
+
+    cout << setw(17) << left << "table" << right << setw(12) << "direct" << setw(13) << "virtual" << endl;
+    benchmark<BinarySearchST<string_view, int>>("binary_search", text);
+    benchmark<FibonacciSearchST<string_view, int>>("fibonacci_search", text);
+
+    return (0);
+}
@@ -1,11 +1,14 @@
 #ifndef __FIB_SEARCH_H__
 #define __FIB_SEARCH_H__
 
+#include <algorithm>
+
+#include "simd_search.h"
 #include "st.h"
 
 // Implements the class for a symbol table based on Fibonacci search
 template <typename Key, typename Value>
-class FibonacciSearchST : public ST<Key, Value> {
+class FibonacciSearchST {
     const int initial_capacity = 2;  // initial capacity of the key/values array
 
     Key* keys;    // array for the keys
@@ -53,6 +56,20 @@ class FibonacciSearchST : public ST<Key, Value> {
         return;
     }
 
+    // inserts a new key-value pair at position i
+    void insert(const int i, const Key& key, const Value& val) {
+        if (n == length) resize(2 * length);
+
+        for (int j = n; j > i; j--) {
+            keys[j] = keys[j - 1];
+            vals[j] = vals[j - 1];
+        }
+        keys[i] = key;
+        vals[i] = val;
+        n++;
+        return;
+    }
+
    public:
     // default constructor
     FibonacciSearchST() : n(0), length(initial_capacity) {
@@ -60,6 +77,11 @@ class FibonacciSearchST : public ST<Key, Value> {
         vals = new Value[length];
     }
 
+    // constructor that builds the table from count key-value pairs in any order in O(n log n)
+    FibonacciSearchST(const Key* new_keys, const Value* new_vals, const int count) : FibonacciSearchST() {
+        put_batch(new_keys, new_vals, count);
+    }
+
     // copy constructor
     FibonacciSearchST(const FibonacciSearchST& st) : n(st.n) {
         deep_copy_keys_and_values(st.keys, st.vals, st.length);
@@ -115,15 +137,51 @@ class FibonacciSearchST : public ST<Key, Value> {
         }
 
         // insert new key-value pair
-        if (n == length) resize(2 * length);
+        insert(i, key, val);
+        return;
+    }
 
-        for (int j = n; j > i; j--) {
-            keys[j] = keys[j - 1];
-            vals[j] = vals[j - 1];
+    // puts count key-value pairs into the table at once (a later pair wins over an earlier one with the same
+    // key): the pairs are sorted and merged with the table in a single pass into arrays that are resized
+    // only once, which takes O(n + count log count) instead of O(n) per pair
+    void put_batch(const Key* new_keys, const Value* new_vals, const int count) {
+        if (count <= 0) return;
+
+        // sort the pairs by key (stable, so that the last pair of equal keys comes last)
+        int* order = new int[count];
+        for (int j = 0; j < count; j++) order[j] = j;
+        std::stable_sort(order, order + count, [&](int x, int y) { return (new_keys[x] < new_keys[y]); });
+
+        // allocate arrays that are large enough for all keys
+        int new_length = (length > initial_capacity) ? length : initial_capacity;
+        while (new_length < n + count) new_length *= 2;
+        auto tmp_keys = new Key[new_length];
+        auto tmp_vals = new Value[new_length];
+
+        // merge the keys of the table with the sorted pairs
+        int i = 0, j = 0, k = 0;
+        while (i < n || j < count) {
+            // only the last of the pairs with equal keys counts
+            while (j + 1 < count && !(new_keys[order[j]] < new_keys[order[j+1]])) j++;
+
+            if (j == count || (i < n && keys[i] < new_keys[order[j]])) {
+                tmp_keys[k] = keys[i];
+                tmp_vals[k++] = vals[i++];
+            } else {
+                // the pair replaces the value of a key that is already in the table
+                if (i < n && keys[i] == new_keys[order[j]]) i++;
+                tmp_keys[k] = new_keys[order[j]];
+                tmp_vals[k++] = new_vals[order[j++]];
+            }
         }
-        keys[i] = key;
-        vals[i] = val;
-        n++;
+        delete[] order;
+
+        // free existing arrays and assign the merged arrays
+        free_arrays();
+        keys = tmp_keys;
+        vals = tmp_vals;
+        length = new_length;
+        n = k;
 
         return;
     }
@@ -140,6 +198,13 @@ class FibonacciSearchST : public ST<Key, Value> {
         return (nullptr);
     }
 
+    // gets the value for a given key to update in place, putting the key with val first if it is new
+    Value& get_or_insert(const Key& key, const Value& val) {
+        int i = rank(key);
+        if (i == n || keys[i] != key) insert(i, key, val);
+        return (vals[i]);
+    }
+
     // removes a key from the table
     void remove(const Key& key) {
         // if array is empty, nothing can be removed
@@ -164,6 +229,13 @@ class FibonacciSearchST : public ST<Key, Value> {
 
     // returns the number of keys in this symbol table strictly less than key
     int rank(const Key& key) const {
+        if constexpr (SimdRank<Key>::enabled)
+            return (SimdRank<Key>::rank(keys, n, key));
+        return (fibonacci_rank(key));
+    }
+
+    // returns the number of keys strictly less than key by Fibonacci search
+    int fibonacci_rank(const Key& key) const {
         if (is_empty())
             return (0);
 
@@ -217,6 +289,15 @@ class FibonacciSearchST : public ST<Key, Value> {
 
     // number of key-value pairs in the table
     int size() const { return (n); }
+
+    // calls visit(key, value) for all key-value pairs in order of the keys
+    template <typename Visit>
+    void for_each(Visit visit) const {
+        for (auto i = 0; i < n; i++) {
+            visit(keys[i], vals[i]);
+        }
+        return;
+    }
 };
 
 #endif
\ No newline at end of file
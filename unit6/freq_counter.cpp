@@ -17,51 +17,101 @@ business 122
 distinct = 5131
 words    = 14350
 
+the input is mapped into memory (or read at once from a pipe) and split into
+words in place, so the keys of the symbol tables are views into the input (the
+binary search table copies them into its packed string arena); the file may
+also be given after the minimum length
+
+    ./freq_counter_binary_search 8 ../data/tale.txt
+
+a number of threads after the file counts in parallel (parallel_counter.h) with
+1, 2, 4, ... up to that number of threads and reports the throughput of each
+
+    ./freq_counter_binary_search 8 ../data/tale.txt 4
+
+threads        time        MB/s
+      1     ... ms         ...
+      2     ... ms         ...
+      4     ... ms         ...
+business 122
+distinct = 5131
+words    = 14350
+
 */
 
+#include <chrono>
 #include <cstdlib>
 #include <iomanip>
 #include <iostream>
 #include <string>
+#include <string_view>
 
+#include "freq_counter.h"
+#include "parallel_counter.h"
 #include "st.h"
+#include "tokenizer.h"
+
+using namespace std;
 
 #ifdef SEQ_SEARCH
 #include "seqsearch.h"
+using Table = SeqSearchST<string_view, int>;
 #endif
 
 #ifdef BINARY_SEARCH
 #include "binarysearch.h"
+using Table = BinarySearchST<string_view, int>;
 #endif
 
 #ifdef FIBONACCI_SEARCH
 #include "fibsearch.h"
+using Table = FibonacciSearchST<string_view, int>;
 #endif
 
-using namespace std;
+// performs the frequency counting test on the words of the text with direct calls to the table
+template <typename Table>
+void freq_counter(Table& st, const MappedFile& text, int min_len) {
+    auto result = freq_count(st, text.data(), text.size(), min_len);
 
-// performs the frequency counting test
-void freq_counter(ST<string, int>* st, int min_len) {
-    int distinct = 0, words = 0;
-    string max_str = "";
+    // output final statistics
+    cout << result.max_str << " " << result.max_cnt << endl;
+    cout << "distinct = " << result.distinct << endl;
+    cout << "words    = " << result.words << endl;
+
+    return;
+}
+
+// performs the frequency counting test in parallel with 1, 2, 4, ... and max_threads threads, reporting the
+// throughput of every number of threads (the most frequent word is the same as for the sequential count)
+template <typename Table>
+void parallel_freq_counter(const MappedFile& text, int min_len, int max_threads) {
+    long long distinct = 0, words = 0;
+    string_view max_str = "";
     int max_cnt = 0;
 
-    string key;
-    while (cin >> key) {
-        if (key.length() < min_len) continue;
-
-        words++;
-        if (st->contains(key)) {
-            auto new_count = *(st->get(key)) + 1;
-            if (new_count > max_cnt) {
-                max_cnt = new_count;
-                max_str = key;
-            }
-            st->put(key, new_count);
-        } else {
-            st->put(key, 1);
-            distinct++;
+    cout << setw(7) << "threads" << setw(12) << "time" << setw(12) << "MB/s" << endl;
+    for (auto threads = 1; threads <= max_threads; threads *= 2) {
+        // always finish with the maximum number of threads
+        if (threads > max_threads / 2) threads = max_threads;
+
+        auto last_str = max_str;
+        auto last_cnt = max_cnt;
+        auto last_distinct = distinct;
+        auto start = chrono::steady_clock::now();
+        Table* st =
+            parallel_count_words<Table>(text.data(), text.size(), min_len, threads, words, max_str, max_cnt);
+        auto stop = chrono::steady_clock::now();
+        auto ms = chrono::duration<double, milli>(stop - start).count();
+
+        distinct = st->size();
+        delete st;
+
+        cout << setw(7) << threads << fixed << setprecision(1) << setw(9) << ms << " ms" << setw(12)
+             << text.size() / ms / 1000;
+        if (threads > 1 && (max_str != last_str || max_cnt != last_cnt || distinct != last_distinct)) {
+            cout << " (counts differ!)";
         }
+        cout << endl;
     }
 
     // output final statistics
@@ -74,28 +124,18 @@ void freq_counter(ST<string, int>* st, int min_len) {
 
 // main entry point of the program
 int main(int argc, char* argv[]) {
-    int min_len = (argc == 2) ? atoi(argv[1]) : 1;
+    int min_len = (argc >= 2) ? atoi(argv[1]) : 1;
+    MappedFile text = (argc >= 3) ? MappedFile(string(argv[2])) : MappedFile(0);
+    int threads = (argc >= 4) ? atoi(argv[3]) : 0;
 
-#ifdef SEQ_SEARCH
-    // compute frequency counts
-    SeqSearchST<string, int>* seq_search_st = new SeqSearchST<string, int>();
-    freq_counter(seq_search_st, min_len);
-    delete seq_search_st;
-#endif
-
-#ifdef BINARY_SEARCH
     // compute frequency counts
-    BinarySearchST<string, int>* binary_search_st = new BinarySearchST<string, int>();
-    freq_counter(binary_search_st, min_len);
-    delete binary_search_st;
-#endif
-
-#ifdef FIBONACCI_SEARCH
-    // compute frequency counts
-    FibonacciSearchST<string, int>* fib_search_st = new FibonacciSearchST<string, int>();
-    freq_counter(fib_search_st, min_len);
-    delete fib_search_st;
-#endif
+    if (threads > 0) {
+        parallel_freq_counter<Table>(text, min_len, threads);
+    } else {
+        Table* st = new Table();
+        freq_counter(*st, text, min_len);
+        delete st;
+    }
 
     return (0);
 }
\ No newline at end of file
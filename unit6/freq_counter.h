@@ -0,0 +1,44 @@
+#ifndef __FREQ_COUNTER_H__
+#define __FREQ_COUNTER_H__
+
+#include <cstddef>
+#include <string_view>
+
+#include "st.h"
+#include "tokenizer.h"
+
+// the result of a frequency count
+struct FreqCount {
+    std::string_view max_str;  // the first word to reach the top count (of at least 2)
+    int max_cnt;               // number of occurrences of max_str
+    long long distinct;        // number of distinct words
+    long long words;           // number of words
+};
+
+// Counts the words of at least min_len characters of the text into the table with a single search per word
+// (the keys are views into the text). The table may be of any class with the member functions of ST (see
+// is_symbol_table), whose calls are then resolved at compile time; for ST itself they stay virtual calls
+template <typename Table>
+FreqCount freq_count(Table& st, const char* text, const size_t length, const int min_len) {
+    static_assert(is_symbol_table<Table, std::string_view, int>::value, "the table must map words to counts");
+    FreqCount result{"", 0, 0, 0};
+
+    Tokenizer tokenizer(text, length);
+    std::string_view key;
+    while (tokenizer.next(key)) {
+        if ((int)key.length() < min_len) continue;
+
+        result.words++;
+        auto& count = st.get_or_insert(key, 0);
+        if (count == 0) {
+            result.distinct++;
+        } else if (count + 1 > result.max_cnt) {
+            result.max_cnt = count + 1;
+            result.max_str = key;
+        }
+        count++;
+    }
+    return (result);
+}
+
+#endif
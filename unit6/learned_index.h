@@ -0,0 +1,208 @@
+#ifndef __LEARNED_INDEX_H__
+#define __LEARNED_INDEX_H__
+
+#include <type_traits>
+
+#include "simd_search.h"
+
+// Implements a learned index over the sorted numeric keys of a symbol table: a piecewise linear model that
+// maps a key onto its position with an error of at most error positions. The segments are fitted in a single
+// pass (shrinking cone): a segment grows as long as one line through its first point passes within error of
+// all its points. A lookup finds the segment by a binary search over the first keys of the segments (which
+// are few and stay in the cache) and then only searches the keys in the window around the predicted position.
+template <typename Key>
+class PiecewiseLinearModel {
+    Key* first_keys;  // first key of every segment
+    int* starts;      // position of the first key of every segment; starts[segments] is n
+    double* slopes;   // slope of every segment (positions per key unit)
+    int segments;     // number of segments
+    int error;        // maximum distance between the predicted and the actual position of a key
+
+    // copys the segments of another model
+    void deep_copy(const PiecewiseLinearModel& model) {
+        segments = model.segments;
+        error = model.error;
+        first_keys = nullptr;
+        starts = nullptr;
+        slopes = nullptr;
+        if (model.is_built()) {
+            first_keys = new Key[segments];
+            starts = new int[segments + 1];
+            slopes = new double[segments];
+            for (auto s = 0; s < segments; s++) {
+                first_keys[s] = model.first_keys[s];
+                starts[s] = model.starts[s];
+                slopes[s] = model.slopes[s];
+            }
+            starts[segments] = model.starts[segments];
+        }
+        return;
+    }
+
+    // fits the segments to the sorted keys[0..n-1] (which may repeat) and returns their number; they are only
+    // stored once the arrays have been allocated
+    int fit(const Key* keys, const int n) {
+        segments = 0;
+        int start = 0;
+        double lo_slope = 0, hi_slope = -1;  // slopes of the lines that fit all points so far (hi < 0: any)
+        for (auto i = 1; i <= n; i++) {
+            if (i < n) {
+                // the slopes of the lines through the first point that pass within error of (keys[i], i)
+                const double dx = (double)keys[i] - (double)keys[start];
+                const double dy = i - start;
+                if (dx <= 0 && dy <= error) {
+                    // keys that are equal as doubles fit as long as they are close enough
+                    continue;
+                }
+                if (dx > 0) {
+                    const double lo = (dy - error) / dx, hi = (dy + error) / dx;
+                    const double new_lo = (lo > lo_slope) ? lo : lo_slope;
+                    const double new_hi = (hi_slope < 0 || hi < hi_slope) ? hi : hi_slope;
+                    if (new_lo <= new_hi) {
+                        lo_slope = new_lo;
+                        hi_slope = new_hi;
+                        continue;
+                    }
+                }
+            }
+
+            // the segment of keys[start..i-1] is complete
+            if (first_keys != nullptr) {
+                first_keys[segments] = keys[start];
+                starts[segments] = start;
+                slopes[segments] = (hi_slope < 0) ? lo_slope : (lo_slope + hi_slope) / 2;
+            }
+            segments++;
+            start = i;
+            lo_slope = 0;
+            hi_slope = -1;
+        }
+        if (first_keys != nullptr) {
+            starts[segments] = n;
+        }
+        return (segments);
+    }
+
+   public:
+    // default constructor (no model)
+    PiecewiseLinearModel() : first_keys(nullptr), starts(nullptr), slopes(nullptr), segments(0), error(0) {}
+
+    // copy constructor
+    PiecewiseLinearModel(const PiecewiseLinearModel& model) {
+        deep_copy(model);
+    }
+
+    // move constructor
+    PiecewiseLinearModel(PiecewiseLinearModel&& model)
+        : first_keys(model.first_keys), starts(model.starts), slopes(model.slopes), segments(model.segments),
+          error(model.error) {
+        model.first_keys = nullptr;
+        model.starts = nullptr;
+        model.slopes = nullptr;
+        model.segments = 0;
+    }
+
+    // copy assignment
+    PiecewiseLinearModel& operator=(const PiecewiseLinearModel& model) {
+        clear();
+        deep_copy(model);
+        return (*this);
+    }
+
+    // move assignment
+    PiecewiseLinearModel& operator=(PiecewiseLinearModel&& model) {
+        clear();
+        first_keys = model.first_keys;
+        starts = model.starts;
+        slopes = model.slopes;
+        segments = model.segments;
+        error = model.error;
+        model.first_keys = nullptr;
+        model.starts = nullptr;
+        model.slopes = nullptr;
+        model.segments = 0;
+        return (*this);
+    }
+
+    // destructor
+    ~PiecewiseLinearModel() {
+        clear();
+    }
+
+    // fits the model to the sorted keys[0..n-1] (which may repeat) with the given maximum error
+    void build(const Key* keys, const int n, const int max_error) {
+        static_assert(std::is_arithmetic<Key>::value, "the learned index needs numeric keys");
+        clear();
+        error = max_error;
+
+        // the first pass only counts the segments
+        const int count = fit(keys, n);
+        first_keys = new Key[count];
+        starts = new int[count + 1];
+        slopes = new double[count];
+        fit(keys, n);
+        return;
+    }
+
+    // drops the model
+    void clear() {
+        delete[] first_keys;
+        delete[] starts;
+        delete[] slopes;
+        first_keys = nullptr;
+        starts = nullptr;
+        slopes = nullptr;
+        segments = 0;
+        return;
+    }
+
+    // checks if the model has been built
+    bool is_built() const { return (first_keys != nullptr); }
+
+    // number of segments of the model
+    int size() const { return (segments); }
+
+    // maximum distance between the predicted and the actual position of a key
+    int max_error() const { return (error); }
+
+    // returns the number of keys in the sorted keys[0..n-1] (the keys of the model) strictly less than key
+    int rank(const Key* keys, const int n, const Key& key) const {
+        if (segments == 0 || key <= first_keys[0])
+            return (0);
+
+        // find the last segment whose first key is less than key
+        int lo = 0, hi = segments - 1;
+        while (lo < hi) {
+            int mid = hi - (hi - lo) / 2;
+            if (first_keys[mid] < key)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+
+        // predict the position within the segment; a key after the last key of the segment has the rank of
+        // the segment end, which the window then still contains (the window never reaches past keys[n-1])
+        const int start = starts[lo], end = (starts[lo + 1] < n) ? starts[lo + 1] : n;
+        double predicted = start + slopes[lo] * ((double)key - (double)first_keys[lo]);
+        if (predicted > end - 1) predicted = end - 1;
+        const int pos = (int)predicted;
+        const int from = (pos - error - 1 > start) ? pos - error - 1 : start;
+        const int to = (pos + error + 2 < end) ? pos + error + 2 : end;
+
+        // search the window keys[from..to-1]
+        if constexpr (SimdRank<Key>::enabled) {
+            return (from + SimdRank<Key>::rank(keys + from, to - from, key));
+        }
+        int l = from, h = to;
+        while (l < h) {
+            int mid = l + (h - l) / 2;
+            if (keys[mid] < key)
+                l = mid + 1;
+            else
+                h = mid;
+        }
+        return (l);
+    }
+};
+
+#endif
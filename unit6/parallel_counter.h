@@ -0,0 +1,165 @@
+#ifndef __PARALLEL_COUNTER_H__
+#define __PARALLEL_COUNTER_H__
+
+#include <algorithm>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "tokenizer.h"
+
+// a word, its number of occurrences and the offset of its last occurrence in the text
+struct WordCount {
+    std::string_view word;
+    int count;
+    size_t last;
+};
+
+// returns the offsets that split the text into chunks of about the same size (chunk i is the text between
+// the offsets i and i+1); every inner offset is moved forward to white space so that no word is split
+inline std::vector<size_t> split_at_space(const char* text, const size_t length, const int chunks) {
+    std::vector<size_t> offsets(chunks + 1, length);
+    offsets[0] = 0;
+    for (auto i = 1; i < chunks; i++) {
+        size_t offset = (length / chunks) * i;
+        if (offset < offsets[i-1]) offset = offsets[i-1];
+        while (offset < length && !is_space(text[offset])) offset++;
+        offsets[i] = offset;
+    }
+    return (offsets);
+}
+
+// counts the words of at least min_len characters of the chunk text[begin..end-1] and returns their number:
+// the table maps every word to its index in counts, which keeps the word (as a view into the text), its
+// count and the offset of its last occurrence
+template <typename Table>
+long long count_words(Table& st, std::vector<WordCount>& counts, const char* text, const size_t begin,
+                      const size_t end, const int min_len) {
+    long long words = 0;
+    Tokenizer tokenizer(text + begin, end - begin);
+    std::string_view key;
+    while (tokenizer.next(key)) {
+        if ((int)key.length() < min_len) continue;
+        words++;
+        auto& index = st.get_or_insert(key, (int)counts.size());
+        if (index == (int)counts.size()) counts.push_back({key, 0, 0});
+        counts[index].count++;
+        counts[index].last = key.data() - text;
+    }
+    return (words);
+}
+
+// returns the counts of two lists sorted by word as one sorted list (adding the counts of equal words and
+// keeping the later of their last occurrences)
+inline std::vector<WordCount> merge_counts(const std::vector<WordCount>& a, const std::vector<WordCount>& b) {
+    std::vector<WordCount> merged;
+    merged.reserve(a.size() + b.size());
+    size_t i = 0, j = 0;
+    while (i < a.size() && j < b.size()) {
+        if (a[i].word < b[j].word) {
+            merged.push_back(a[i++]);
+        } else if (b[j].word < a[i].word) {
+            merged.push_back(b[j++]);
+        } else {
+            merged.push_back({a[i].word, a[i].count + b[j].count, std::max(a[i].last, b[j].last)});
+            i++;
+            j++;
+        }
+    }
+    merged.insert(merged.end(), a.begin() + i, a.end());
+    merged.insert(merged.end(), b.begin() + j, b.end());
+    return (merged);
+}
+
+// puts the sorted counts[lo..hi-1] into the table middle first, so that an unbalanced search tree is built
+// with the height of a balanced one
+template <typename Table>
+void put_middle_first(Table& st, const std::vector<WordCount>& counts, const size_t lo, const size_t hi) {
+    if (lo >= hi) return;
+    size_t mid = lo + (hi - lo) / 2;
+    st.put(counts[mid].word, counts[mid].count);
+    put_middle_first(st, counts, lo, mid);
+    put_middle_first(st, counts, mid + 1, hi);
+    return;
+}
+
+// Counts the words of at least min_len characters of the text with the given number of threads and returns
+// the table of all counts (the keys are views into the text), the number of words and the most frequent word
+// with its count: the text is split at white space into one chunk per thread, every thread counts its chunk
+// into a table of its own, and the tables are merged at the end. The counts of every table are sorted by word
+// (as they come out of an ordered table already), merged pairwise in rounds and put into the resulting table
+// at once, with the bulk-load constructor if the table has one. The most frequent word is the one that a
+// sequential count (freq_count) reports, the first word to reach the top count: as a word reaches its final
+// count at its last occurrence, that is the word of the top count whose last occurrence comes first
+template <typename Table>
+Table* parallel_count_words(const char* text, const size_t length, const int min_len, const int threads,
+                            long long& words, std::string_view& max_str, int& max_cnt) {
+    auto offsets = split_at_space(text, length, threads);
+    std::vector<Table> tables(threads);
+    std::vector<std::vector<WordCount>> runs(threads);
+    std::vector<long long> chunk_words(threads, 0);
+    std::vector<std::thread> workers;
+    for (auto t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            chunk_words[t] = count_words(tables[t], runs[t], text, offsets[t], offsets[t+1], min_len);
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    // sort the counts of every chunk by word, in the order of its table
+    words = 0;
+    for (auto t = 0; t < threads; t++) {
+        words += chunk_words[t];
+        std::vector<WordCount> sorted;
+        sorted.reserve(runs[t].size());
+        tables[t].for_each([&](const std::string_view&, const int index) {
+            sorted.push_back(runs[t][index]);
+        });
+        auto by_word = [](const WordCount& a, const WordCount& b) { return (a.word < b.word); };
+        if (!std::is_sorted(sorted.begin(), sorted.end(), by_word)) {
+            std::sort(sorted.begin(), sorted.end(), by_word);
+        }
+        runs[t] = std::move(sorted);
+        tables[t] = Table();
+    }
+
+    // merge the runs pairwise until one is left
+    while (runs.size() > 1) {
+        std::vector<std::vector<WordCount>> merged;
+        for (size_t r = 0; r + 1 < runs.size(); r += 2) merged.push_back(merge_counts(runs[r], runs[r+1]));
+        if (runs.size() % 2 == 1) merged.push_back(std::move(runs.back()));
+        runs = std::move(merged);
+    }
+    const auto& counts = runs[0];
+
+    // the most frequent word (of the words that occur more than once)
+    max_str = "";
+    max_cnt = 0;
+    size_t max_last = 0;
+    for (const auto& wc : counts) {
+        if (wc.count > 1 && (wc.count > max_cnt || (wc.count == max_cnt && wc.last < max_last))) {
+            max_cnt = wc.count;
+            max_last = wc.last;
+            max_str = wc.word;
+        }
+    }
+
+    // put the counts into one table
+    if constexpr (std::is_constructible<Table, const std::string_view*, const int*, int>::value) {
+        std::vector<std::string_view> keys(counts.size());
+        std::vector<int> vals(counts.size());
+        for (size_t i = 0; i < counts.size(); i++) {
+            keys[i] = counts[i].word;
+            vals[i] = counts[i].count;
+        }
+        return (new Table(keys.data(), vals.data(), counts.size()));
+    } else {
+        auto st = new Table();
+        put_middle_first(*st, counts, 0, counts.size());
+        return (st);
+    }
+}
+
+#endif
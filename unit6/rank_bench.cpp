@@ -0,0 +1,94 @@
+/*
+    ./rank_bench 1000000
+
+compares the time per rank() of the binary search, the Fibonacci search, the
+vectorized k-ary search (simd_search.h, int and float keys with AVX2), the
+frozen Eytzinger search and the learned index (learned_index.h, with the default
+error of 32 positions) on tables of 1K, 64K, 1M and 16M random keys
+
+int keys          binary  fibonacci       simd     frozen    learned
+n = 1024        ... ns     ... ns     ... ns     ... ns     ... ns
+...
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "binarysearch.h"
+#include "fibsearch.h"
+
+using namespace std;
+
+// returns the time per call of rank in ns over all queries (and adds the ranks to checksum)
+template <typename Rank, typename Key>
+double ns_per_rank(const vector<Key>& queries, Rank rank, long long& checksum) {
+    auto start = chrono::steady_clock::now();
+    for (const auto& q : queries) {
+        checksum += rank(q);
+    }
+    auto stop = chrono::steady_clock::now();
+    return (chrono::duration<double, nano>(stop - start).count() / queries.size());
+}
+
+// runs all searches on tables of random keys of one type
+template <typename Key>
+void benchmark(const string& type_name, const int queries_count) {
+    cout << setw(12) << left << (type_name + " keys") << right << setw(10) << "binary" << setw(11) << "fibonacci"
+         << setw(11) << "simd" << setw(11) << "frozen"
+         << setw(11) << "learned" << endl;
+
+    mt19937 rng(42);
+    for (auto n : {1 << 10, 1 << 16, 1 << 20, 1 << 24}) {
+        vector<Key> keys(n);
+        vector<int> vals(n, 0);
+        for (auto& k : keys) k = static_cast<Key>(rng() % (4u * n));
+        BinarySearchST<Key, int> binary_st(keys.data(), vals.data(), n);
+        FibonacciSearchST<Key, int> fib_st(keys.data(), vals.data(), n);
+
+        vector<Key> queries(queries_count);
+        for (auto& q : queries) q = static_cast<Key>(rng() % (4u * n));
+
+        long long checksum[5] = {0, 0, 0, 0, 0};
+        double ns[5];
+        ns[0] = ns_per_rank(queries, [&](const Key& k) { return (binary_st.binary_rank(k)); }, checksum[0]);
+        ns[1] = ns_per_rank(queries, [&](const Key& k) { return (fib_st.fibonacci_rank(k)); }, checksum[1]);
+        ns[2] = ns_per_rank(queries, [&](const Key& k) { return (binary_st.rank(k)); }, checksum[2]);
+        binary_st.freeze();
+        ns[3] = ns_per_rank(queries, [&](const Key& k) { return (binary_st.rank(k)); }, checksum[3]);
+        binary_st.thaw();
+        binary_st.learn();
+        ns[4] = ns_per_rank(queries, [&](const Key& k) { return (binary_st.rank(k)); }, checksum[4]);
+
+        cout << "n = " << setw(8) << left << n << right << fixed << setprecision(1);
+        for (auto i = 0; i < 5; i++) {
+            cout << setw(8) << ns[i] << " ns";
+        }
+        if (checksum[1] != checksum[0] || checksum[2] != checksum[0] || checksum[3] != checksum[0] ||
+            checksum[4] != checksum[0]) {
+            cout << " (ranks differ!)";
+        }
+        cout << endl;
+    }
+    return;
+}
+
+// main entry point of the program
+int main(int argc, char* argv[]) {
+    int queries = (argc == 2) ? atoi(argv[1]) : 1000000;
+
+#ifndef __AVX2__
+    cout << "compiled without AVX2: simd is the binary search" << endl;
+#endif
+    benchmark<int>("int", queries);
+    cout << endl;
+    benchmark<float>("float", queries);
+
+    return (0);
+}
@@ -0,0 +1,151 @@
+/*
+    ./selforg_bench ../data/tale.txt 1000000
+
+compares the average number of probes and the time per get() of the sequential
+search symbol table without reordering, with move-to-front and with transpose on
+two skewed workloads: the words of a text looked up in the order of the text (the
+table holds the distinct words in the order of their first occurrence), and
+Zipfian (s = 1) lookups of 10000 int keys inserted in random order
+
+tale.txt: 10xxx distinct words, 135635 lookups
+policy           probes/get     ns/get
+none                    ...        ...
+move_to_front           ...        ...
+transpose               ...        ...
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "seqsearch.h"
+
+using namespace std;
+
+// a key that counts all comparisons of keys, which are the probes of the sequential search (so that the
+// symbol table itself does not have to count them)
+template <typename Key>
+struct CountedKey {
+    static long long comparisons;  // number of comparisons so far
+    Key key;
+
+    bool operator==(const CountedKey& other) const {
+        comparisons++;
+        return (key == other.key);
+    }
+};
+
+template <typename Key>
+long long CountedKey<Key>::comparisons = 0;
+
+// fills a table with the policy with the keys
+template <typename Key>
+void fill(SeqSearchST<Key, int>& st, const vector<Key>& keys) {
+    for (const auto& k : keys) st.put(k, 1);
+    return;
+}
+
+// looks up all queries and returns the sum of the values found
+template <typename Key>
+long long lookup(const SeqSearchST<Key, int>& st, const vector<Key>& queries) {
+    long long found = 0;
+    for (const auto& q : queries) {
+        auto val = st.get(q);
+        if (val != nullptr) found += *val;
+    }
+    return (found);
+}
+
+// looks up all queries in a table with the policy and prints the probes and time per get; the probes are
+// counted in a second run with CountedKey, which visits the same nodes, so that the timed run is not slowed
+template <typename Key>
+void run(const string& name, const SelfOrganizing policy, const vector<Key>& keys, const vector<Key>& queries) {
+    SeqSearchST<Key, int> st(policy);
+    fill(st, keys);
+    auto start = chrono::steady_clock::now();
+    long long found = lookup(st, queries);
+    auto stop = chrono::steady_clock::now();
+
+    vector<CountedKey<Key>> counted_keys, counted_queries;
+    for (const auto& k : keys) counted_keys.push_back({k});
+    for (const auto& q : queries) counted_queries.push_back({q});
+    SeqSearchST<CountedKey<Key>, int> counted(policy);
+    fill(counted, counted_keys);
+    CountedKey<Key>::comparisons = 0;
+    lookup(counted, counted_queries);
+    auto probes = CountedKey<Key>::comparisons;
+
+    cout << setw(16) << left << name << right << fixed << setprecision(1) << setw(11)
+         << (double)probes / queries.size() << setw(11)
+         << chrono::duration<double, nano>(stop - start).count() / queries.size();
+    if (found != (long long)queries.size()) {
+        cout << " (keys missing!)";
+    }
+    cout << endl;
+    return;
+}
+
+// runs all policies on one workload
+template <typename Key>
+void benchmark(const vector<Key>& keys, const vector<Key>& queries) {
+    cout << setw(16) << left << "policy" << right << setw(11) << "probes/get" << setw(11) << "ns/get" << endl;
+    run("none", SelfOrganizing::none, keys, queries);
+    run("move_to_front", SelfOrganizing::move_to_front, keys, queries);
+    run("transpose", SelfOrganizing::transpose, keys, queries);
+    return;
+}
+
+// main entry point of the program
+int main(int argc, char* argv[]) {
+    string file = (argc >= 2) ? argv[1] : "../data/tale.txt";
+    int lookups = (argc >= 3) ? atoi(argv[2]) : 1000000;
+
+    // the words of the text in the order of the text, and the distinct words by their first occurrence
+    ifstream in(file);
+    vector<string> words, distinct;
+    string word;
+    while (in >> word) words.push_back(word);
+    {
+        SeqSearchST<string, int> seen(SelfOrganizing::move_to_front);
+        for (const auto& w : words) {
+            if (!seen.contains(w)) {
+                seen.put(w, 1);
+                distinct.push_back(w);
+            }
+        }
+    }
+    cout << file << ": " << distinct.size() << " distinct words, " << words.size() << " lookups" << endl;
+    benchmark(distinct, words);
+    cout << endl;
+
+    // Zipfian lookups: the key of rank r (a random permutation of the keys) has weight 1 / r
+    const int n = 10000;
+    mt19937 rng(42);
+    vector<int> keys(n);
+    for (auto i = 0; i < n; i++) keys[i] = i;
+    shuffle(keys.begin(), keys.end(), rng);
+    vector<double> cdf(n);
+    double sum = 0;
+    for (auto r = 0; r < n; r++) {
+        sum += 1.0 / (r + 1);
+        cdf[r] = sum;
+    }
+    vector<int> queries(lookups);
+    uniform_real_distribution<double> uniform(0, sum);
+    for (auto& q : queries) {
+        auto r = lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin();
+        q = keys[(r < n) ? r : n - 1];
+    }
+    shuffle(keys.begin(), keys.end(), rng);
+    cout << "zipf (s = 1): " << n << " int keys, " << lookups << " lookups" << endl;
+    benchmark(keys, queries);
+
+    return (0);
+}
@@ -1,121 +1,239 @@
 #ifndef __SEQ_SEARCH_H__
 #define __SEQ_SEARCH_H__
 
+#include <utility>
+
 #include "st.h"
 
-// Implements the class for a symbol table based on sequential search
+// the rules by which a self-organizing list moves a key that a search has found
+enum class SelfOrganizing {
+    none,           // the list keeps its order
+    move_to_front,  // the key moves to the head of the list
+    transpose       // the key swaps places with its predecessor
+};
+
+// Implements the class for a symbol table based on sequential search; the nodes of the linked list live in
+// one pool array, and a self-organizing policy may move the keys that are found towards the head, so that
+// the frequent keys of a skewed workload are found after a few probes. Such a policy changes the list on
+// every get, so that a self-organizing table must not be read by several threads at once; without a policy
+// (the default) get and contains do not change the table.
 template <typename Key, typename Value>
-class SeqSearchST : public ST<Key,Value> {
+class SeqSearchST {
+    const int initial_capacity = 2;
+
     // a helper linked list data type
     struct Node {
         Key key;
         Value val;
         Node* next;
-
-        // constructor with values
-        Node(const Key& k, const Value& v, Node* n) : key(k), val(v), next(n) {}
     };
 
-    int n;       // number of key-value pairs
-    Node* head;  // the linked list of key-value pairs
-
-    // removes a key from list pointed to by x and returns the new head
-    Node* remove(Node* x, const Key& key) {
-        if (x == nullptr) return (nullptr);
-        if (x->key == key) {
-            n--;
-            Node* nxt = x->next;
-            delete x;
-            return nxt;
+    int n;                  // number of key-value pairs
+    Node* pool;             // the nodes of the list and the removed nodes
+    int capacity;           // number of nodes in the pool
+    int used;               // number of nodes of the pool handed out so far
+    mutable Node* head;     // the linked list of key-value pairs (which a self-organizing get reorders)
+    Node* free_list;        // the linked list of removed nodes for reuse
+    SelfOrganizing policy;  // how the nodes move on a hit
+
+    // returns the node of key (or NULL); only a self-organizing policy changes the list
+    Node* find(const Key& key) const {
+        if (policy == SelfOrganizing::none) {
+            for (Node* x = head; x != nullptr; x = x->next) {
+                if (x->key == key) return (x);
+            }
+            return (nullptr);
         }
-        x->next = remove(x->next, key);
-        return x;
+        return (find_and_move(key));
     }
 
-    // copys an existing list
-    const Node* deep_copy_list(const Node* new_head) {
-        if (new_head) {
-            auto tail = deep_copy_list(new_head->next);
-            return (new Node(new_head->key, new_head->val, tail));
-        } 
+    // returns the node of key (or NULL) and moves the node as the policy says
+    Node* find_and_move(const Key& key) const {
+        Node *prev = nullptr, *prev_prev = nullptr;
+        for (Node* x = head; x != nullptr; x = x->next) {
+            if (x->key == key) {
+                if (prev != nullptr && policy == SelfOrganizing::move_to_front) {
+                    prev->next = x->next;
+                    x->next = head;
+                    head = x;
+                } else if (prev != nullptr && policy == SelfOrganizing::transpose) {
+                    prev->next = x->next;
+                    x->next = prev;
+                    if (prev_prev == nullptr)
+                        head = x;
+                    else
+                        prev_prev->next = x;
+                }
+                return (x);
+            }
+            prev_prev = prev;
+            prev = x;
+        }
         return (nullptr);
     }
 
-    // frees the list and sets the head to NULL
-    void free_list() {
+    // copys the nodes of another pool into the pool, pointing their links at the same places in the pool
+    void copy_nodes(Node* from, const bool move) {
+        auto rebase = [&](const Node* x) { return ((x == nullptr) ? nullptr : pool + (x - from)); };
+        for (auto i = 0; i < used; i++) {
+            if (move) {
+                pool[i].key = std::move(from[i].key);
+                pool[i].val = std::move(from[i].val);
+            } else {
+                pool[i].key = from[i].key;
+                pool[i].val = from[i].val;
+            }
+            pool[i].next = rebase(from[i].next);
+        }
+        head = rebase(head);
+        free_list = rebase(free_list);
+        return;
+    }
+
+    // moves the pool into a new array of the given capacity
+    void resize(const int new_capacity) {
+        auto old_pool = pool;
+        pool = new Node[new_capacity];
+        copy_nodes(old_pool, true);
+        delete[] old_pool;
+        capacity = new_capacity;
+        return;
+    }
+
+    // inserts a new key-value pair at the head of the list and returns its node
+    Node* insert(const Key& key, const Value& val) {
+        // take a removed node, or the next node of the pool
+        Node* x;
+        if (free_list != nullptr) {
+            x = free_list;
+            free_list = x->next;
+        } else {
+            if (used == capacity) resize((capacity == 0) ? initial_capacity : 2 * capacity);
+            x = pool + used++;
+        }
+        x->key = key;
+        x->val = val;
+        x->next = head;
+        head = x;
+        n++;
+        return (x);
+    }
 
-        while (head) {
-            Node* tmp = head->next;
-            delete head;
-            head = tmp;
+    // copys the pool of an existing table
+    void deep_copy(const SeqSearchST& st) {
+        n = st.n;
+        capacity = st.capacity;
+        used = st.used;
+        head = st.head;
+        free_list = st.free_list;
+        policy = st.policy;
+        pool = nullptr;
+        if (capacity > 0) {
+            pool = new Node[capacity];
+            copy_nodes(st.pool, false);
         }
         return;
     }
 
+    // frees the pool and empties the list
+    void free_pool() {
+        delete[] pool;
+        pool = head = free_list = nullptr;
+        n = capacity = used = 0;
+        return;
+    }
+
    public:
-    // default constructor
-    SeqSearchST() : n(0), head(nullptr) {}
+    // constructor with the self-organizing policy (none by default)
+    SeqSearchST(const SelfOrganizing p = SelfOrganizing::none)
+        : n(0), pool(nullptr), capacity(0), used(0), head(nullptr), free_list(nullptr), policy(p) {}
 
     // copy constructor
-    SeqSearchST(const SeqSearchST& st) : n(st.n) { head = deep_copy_list(st.head); }
+    SeqSearchST(const SeqSearchST& st) { deep_copy(st); }
 
     // move constructor
-    SeqSearchST(SeqSearchST&& st) : head(st.head), n(st.n) { st.head = nullptr; st.n = 0; }
+    SeqSearchST(SeqSearchST&& st)
+        : n(st.n), pool(st.pool), capacity(st.capacity), used(st.used), head(st.head), free_list(st.free_list),
+          policy(st.policy) {
+        st.pool = nullptr;
+        st.free_pool();
+    }
 
     // copy assignment
     SeqSearchST& operator=(const SeqSearchST& st) {
-        // free the existing list
-        free_list();
-        // copy the list and list length passed in
-        head = deep_copy_list(st.head);
-        n = st.n;
+        // free the existing pool
+        free_pool();
+        // copy the pool and list passed in
+        deep_copy(st);
         return (*this);
     }
 
     // move assignment
     SeqSearchST& operator=(SeqSearchST&& st) {
-        // free the existing list
-        free_list();
+        // free the existing pool
+        free_pool();
 
-        head = st.head;
         n = st.n;
-        st.head = nullptr;
-        st.n = 0;
+        pool = st.pool;
+        capacity = st.capacity;
+        used = st.used;
+        head = st.head;
+        free_list = st.free_list;
+        policy = st.policy;
+        st.pool = nullptr;
+        st.free_pool();
         return (*this);
     }
 
     // destructor
     ~SeqSearchST() {
-        free_list();
+        free_pool();
     }
 
     // put a key-value pair into the table
     void put(const Key& key, const Value& val) {
-        for (Node* x = head; x != nullptr; x = x->next) {
-            if (x->key == key) {
-                x->val = val;
-                return;
-            }
+        Node* x = find(key);
+        if (x != nullptr) {
+            x->val = val;
+            return;
         }
 
-        auto new_head = new Node(key, val, head);
-        head = new_head;
+        insert(key, val);
         return;
     }
 
-    // gets a value for a given key
+    // gets a value for a given key (the pointer is valid until the next put)
     const Value* get(const Key& key) const {
-        for (Node* x = head; x != nullptr; x = x->next) {
-            if (x->key == key) {
-                return &(x->val);
-            }
-        }
-        return (nullptr);
+        Node* x = find(key);
+        return ((x == nullptr) ? nullptr : &(x->val));
+    }
+
+    // gets the value for a given key to update in place, putting the key with val first if it is new
+    Value& get_or_insert(const Key& key, const Value& val) {
+        Node* x = find(key);
+        if (x == nullptr) x = insert(key, val);
+        return (x->val);
     }
 
     // removes a key from the table
     void remove(const Key& key) {
-        head = remove(head, key);
+        Node* prev = nullptr;
+        for (Node* x = head; x != nullptr; prev = x, x = x->next) {
+            if (x->key == key) {
+                if (prev == nullptr)
+                    head = x->next;
+                else
+                    prev->next = x->next;
+
+                // release the contents and keep the node for reuse
+                x->key = Key();
+                x->val = Value();
+                x->next = free_list;
+                free_list = x;
+                n--;
+                return;
+            }
+        }
         return;
     }
 
@@ -129,6 +247,15 @@ class SeqSearchST : public ST<Key,Value> {
 
     // number of key-value pairs in the table
     int size() const { return (n); }
+
+    // calls visit(key, value) for all key-value pairs in the order of the list
+    template <typename Visit>
+    void for_each(Visit visit) const {
+        for (const Node* x = head; x != nullptr; x = x->next) {
+            visit(x->key, x->val);
+        }
+        return;
+    }
 };
 
-#endif
\ No newline at end of file
+#endif
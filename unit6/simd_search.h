@@ -0,0 +1,96 @@
+#ifndef __SIMD_SEARCH_H__
+#define __SIMD_SEARCH_H__
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Implements the selection of the vectorized rank search; the generic version has none, so all other key
+// types (and int and float without AVX2) keep using the scalar searches of the symbol tables
+template <typename Key>
+struct SimdRank {
+    static const bool enabled = false;
+};
+
+#ifdef __AVX2__
+// number of keys below which the vectorized search stops narrowing and scans the rest
+const int SIMD_RANK_LEAF = 32;
+
+// Implements the vectorized rank search over 8 lanes of ints or floats (given by Lanes): every k-ary step
+// gathers 8 evenly spaced pivots that split the range into 9 parts and moves to the part of the key by the
+// number of pivots less than the key (one compare and movemask instead of three branches); the last
+// SIMD_RANK_LEAF keys are counted with compares over contiguous vectors
+template <typename Lanes>
+int simd_rank(const typename Lanes::Key* a, const int n, const typename Lanes::Key key) {
+    const auto k = Lanes::broadcast(key);
+    const __m256i steps = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 8);
+    int lo = 0, len = n;
+
+    // a[lo..lo+len-1] holds the first key that is not less than key (or lo+len is the rank)
+    while (len > SIMD_RANK_LEAF) {
+        const int step = len / 9;
+        const __m256i index = _mm256_add_epi32(_mm256_set1_epi32(lo - 1), _mm256_mullo_epi32(steps, _mm256_set1_epi32(step)));
+        const int less = __builtin_popcount(Lanes::less_mask(Lanes::gather(a, index), k));
+        lo += less * step;
+        len = (less == 8) ? len - 8 * step : step;
+    }
+
+    int rank = lo;
+    int i = lo;
+    for (; i + 8 <= lo + len; i += 8) {
+        rank += __builtin_popcount(Lanes::less_mask(Lanes::load(a + i), k));
+    }
+    for (; i < lo + len; i++) {
+        rank += (a[i] < key);
+    }
+    return (rank);
+}
+
+// Implements the AVX2 operations of the rank search on 8 ints
+struct Avx2RankInt {
+    using Key = int;
+    using Vector = __m256i;
+
+    static Vector load(const int* p) { return (_mm256_loadu_si256((const __m256i*)p)); }
+    static Vector gather(const int* a, const __m256i index) { return (_mm256_i32gather_epi32(a, index, 4)); }
+    static Vector broadcast(const int x) { return (_mm256_set1_epi32(x)); }
+
+    // returns the mask of the lanes of v that are less than k
+    static int less_mask(const Vector v, const Vector k) {
+        return (_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(k, v))));
+    }
+};
+
+// Implements the AVX2 operations of the rank search on 8 floats
+struct Avx2RankFloat {
+    using Key = float;
+    using Vector = __m256;
+
+    static Vector load(const float* p) { return (_mm256_loadu_ps(p)); }
+    static Vector gather(const float* a, const __m256i index) { return (_mm256_i32gather_ps(a, index, 4)); }
+    static Vector broadcast(const float x) { return (_mm256_set1_ps(x)); }
+
+    // returns the mask of the lanes of v that are less than k
+    static int less_mask(const Vector v, const Vector k) { return (_mm256_movemask_ps(_mm256_cmp_ps(v, k, _CMP_LT_OQ))); }
+};
+
+// Implements the vectorized rank search for int keys
+template <>
+struct SimdRank<int> {
+    static const bool enabled = true;
+
+    // returns the number of keys in the sorted a[0..n-1] strictly less than key
+    static int rank(const int* a, const int n, const int key) { return (simd_rank<Avx2RankInt>(a, n, key)); }
+};
+
+// Implements the vectorized rank search for float keys
+template <>
+struct SimdRank<float> {
+    static const bool enabled = true;
+
+    // returns the number of keys in the sorted a[0..n-1] strictly less than key
+    static int rank(const float* a, const int n, const float key) { return (simd_rank<Avx2RankFloat>(a, n, key)); }
+};
+#endif
+
+#endif
@@ -1,14 +1,23 @@
 #ifndef __ST_H__
 #define __ST_H__
 
-// Implements the base class for a symbol table
+#include <type_traits>
+#include <utility>
+
+// Implements the base class for a symbol table (see STAdapter for the symbol tables, which implement the same
+// member functions without virtual calls)
 template <typename Key, typename Value>
 class ST {
    public:
+    // destructor
+    virtual ~ST() {}
+
     // put a key-value pair into the table
     virtual void put(const Key& key, const Value& val) = 0;
     // gets a value for a given key
     virtual const Value* get(const Key& key) const = 0;
+    // gets the value for a given key to update in place, putting the key with val first if it is new
+    virtual Value& get_or_insert(const Key& key, const Value& val) = 0;
     // removes a key from the table
     virtual void remove(const Key& key) = 0;
     // checks if there is a value paired with a key
@@ -19,4 +28,63 @@ class ST {
     virtual int size() const = 0;
 };
 
+// Checks at compile time that a class has the member functions of the symbol table interface ST (without
+// deriving from it), so that a template over the class calls them directly and can inline them
+template <typename Table, typename Key, typename Value, typename = void>
+struct is_symbol_table : std::false_type {};
+
+template <typename Table, typename Key, typename Value>
+struct is_symbol_table<Table, Key, Value,
+                       std::void_t<decltype(std::declval<Table&>().put(std::declval<const Key&>(), std::declval<const Value&>())),
+                                   decltype(std::declval<const Table&>().get(std::declval<const Key&>())),
+                                   decltype(std::declval<Table&>().get_or_insert(std::declval<const Key&>(), std::declval<const Value&>())),
+                                   decltype(std::declval<Table&>().remove(std::declval<const Key&>())),
+                                   decltype(std::declval<const Table&>().contains(std::declval<const Key&>())),
+                                   decltype(std::declval<const Table&>().is_empty()),
+                                   decltype(std::declval<const Table&>().size())>>
+    : std::integral_constant<
+          bool, std::is_convertible<decltype(std::declval<const Table&>().get(std::declval<const Key&>())), const Value*>::value &&
+                    std::is_same<decltype(std::declval<Table&>().get_or_insert(std::declval<const Key&>(), std::declval<const Value&>())), Value&>::value &&
+                    std::is_convertible<decltype(std::declval<const Table&>().contains(std::declval<const Key&>())), bool>::value &&
+                    std::is_convertible<decltype(std::declval<const Table&>().is_empty()), bool>::value &&
+                    std::is_convertible<decltype(std::declval<const Table&>().size()), int>::value> {};
+
+// Implements the virtual interface ST for a symbol table class by forwarding every call to a table of the
+// class, for code that picks the symbol table at run time
+template <typename Key, typename Value, typename Table>
+class STAdapter : public ST<Key, Value> {
+    static_assert(is_symbol_table<Table, Key, Value>::value, "the class does not implement the symbol table interface");
+
+    Table st;  // the symbol table
+
+   public:
+    // default constructor
+    STAdapter() {}
+
+    // constructor with a table
+    explicit STAdapter(const Table& table) : st(table) {}
+
+    // constructor with a table to move from
+    explicit STAdapter(Table&& table) : st(std::move(table)) {}
+
+    // put a key-value pair into the table
+    void put(const Key& key, const Value& val) override { st.put(key, val); }
+    // gets a value for a given key
+    const Value* get(const Key& key) const override { return (st.get(key)); }
+    // gets the value for a given key to update in place, putting the key with val first if it is new
+    Value& get_or_insert(const Key& key, const Value& val) override { return (st.get_or_insert(key, val)); }
+    // removes a key from the table
+    void remove(const Key& key) override { st.remove(key); }
+    // checks if there is a value paired with a key
+    bool contains(const Key& key) const override { return (st.contains(key)); }
+    // checks if the symbol table is empty
+    bool is_empty() const override { return (st.is_empty()); }
+    // number of key-value pairs in the table
+    int size() const override { return (st.size()); }
+
+    // the symbol table
+    Table& table() { return (st); }
+    const Table& table() const { return (st); }
+};
+
 #endif
\ No newline at end of file
@@ -18,7 +18,7 @@
 
 // Implements the class for a symbol table based on separate-chaining hash table
 template <typename Key, typename Value>
-class SeparateChainingHashST : public ST<Key, Value> {
+class SeparateChainingHashST {
     int n;                                  // number of key-value pairs
     int m;                                  // hash-table size
     SequentialSearchST<Key, Value>* table;  // array of linked-list symbol tables
@@ -51,7 +51,7 @@ class SeparateChainingHashST : public ST<Key, Value> {
     SeparateChainingHashST(const SeparateChainingHashST& st) : n(st.n),
                                                                m(st.m) {
         table = new SequentialSearchST<Key, Value>[m];
-        for (auto i = 0; i < m; i++) st[i] = st.table[i];
+        for (auto i = 0; i < m; i++) table[i] = st.table[i];
     }
 
     // move constructor
@@ -98,11 +98,10 @@ class SeparateChainingHashST : public ST<Key, Value> {
 
     // put a key-value pair into the hash table
     void put(const Key& key, const Value& val) {
-        int i = hash(key);
-
         // double table size if average length of list >= 10
         if (n >= 10*m) resize(2*m);
 
+        int i = hash(key);
         if (!table[i].contains(key)) n++;
         table[i].put(key, val);
         return;
@@ -114,6 +113,18 @@ class SeparateChainingHashST : public ST<Key, Value> {
         return (table[i].get(key));
     }
 
+    // gets the value for a given key to update in place, putting the key with val first if it is new
+    Value& get_or_insert(const Key& key, const Value& val) {
+        // double table size if average length of list >= 10
+        if (n >= 10*m) resize(2*m);
+
+        auto& chain = table[hash(key)];
+        auto chain_size = chain.size();
+        auto& value = chain.get_or_insert(key, val);
+        n += chain.size() - chain_size;
+        return (value);
+    }
+
     // removes a key from the table
     void remove(const Key& key) {
         int i = hash(key);
@@ -12,118 +12,234 @@
 #include "st.h"
 #include "queue.h"
 
-// Implements the class for a symbol table based on sequential search in an unordered linked list
+#include <utility>
+
+// the rules by which a self-organizing list moves a key that a search has found
+enum class SelfOrganizing {
+    none,           // the list keeps its order
+    move_to_front,  // the key moves to the head of the list
+    transpose       // the key swaps places with its predecessor
+};
+
+// Implements the class for a symbol table based on sequential search in an unordered linked list; the nodes
+// live in one pool array, and a self-organizing policy may move the keys that are found towards the head (on
+// every get, so that a self-organizing table must not be read by several threads at once)
 template <typename Key, typename Value>
-class SequentialSearchST : public ST<Key, Value> {
+class SequentialSearchST {
+    const int initial_capacity = 2;
+
     // a helper linked list node data type
     struct Node {
         Key key;
         Value val;
         Node* next;
-
-        // constructor with values
-        Node(const Key& k, const Value& v, Node* nxt=nullptr) : key(k), val(v), next(nxt) {}
     };
-    Node* head;  // head of the linked list of key-value pairs
-    int n;       // number of key-value pairs
-
-    // copys an existing linked list pointed to by n into the head
-    void deep_copy_list(const Node* x) {
-        if (x) {
-            head = new Node(x->key, x->val);
-            auto* last = head;
-            while (x->next) {
-                x = x->next;
-                last->next = new Node(x->key, x->val);
-                last = last->next;
+    Node* pool;             // the nodes of the linked list and the removed nodes
+    int capacity;           // number of nodes in the pool
+    int used;               // number of nodes of the pool handed out so far
+    mutable Node* head;     // head of the linked list of key-value pairs (reordered by a self-organizing get)
+    Node* free_list;        // head of the linked list of removed nodes for reuse
+    int n;                  // number of key-value pairs
+    SelfOrganizing policy;  // how the nodes move on a hit
+
+    // returns the node of key (or NULL); only a self-organizing policy changes the list
+    Node* find(const Key& key) const {
+        if (policy == SelfOrganizing::none) {
+            for (auto* it = head; it != nullptr; it = it->next) {
+                if (it->key == key) return (it);
             }
-        } else
-            head = nullptr;
+            return (nullptr);
+        }
+        return (find_and_move(key));
     }
 
-    // frees the linked list pointed to by head
-    void free_list() {
-        while (head) {
-            auto* tmp = head->next;
-            delete head;
-            head = tmp;
+    // returns the node of key (or NULL) and moves the node as the policy says
+    Node* find_and_move(const Key& key) const {
+        Node *prev = nullptr, *prev_prev = nullptr;
+        for (auto* it = head; it != nullptr; it = it->next) {
+            if (it->key == key) {
+                if (prev != nullptr && policy == SelfOrganizing::move_to_front) {
+                    prev->next = it->next;
+                    it->next = head;
+                    head = it;
+                } else if (prev != nullptr && policy == SelfOrganizing::transpose) {
+                    prev->next = it->next;
+                    it->next = prev;
+                    if (prev_prev == nullptr)
+                        head = it;
+                    else
+                        prev_prev->next = it;
+                }
+                return (it);
+            }
+            prev_prev = prev;
+            prev = it;
         }
+        return (nullptr);
+    }
+
+    // copys the nodes of another pool into the pool, pointing their links at the same places in the pool
+    void copy_nodes(Node* from, const bool move) {
+        auto rebase = [&](const Node* x) { return ((x == nullptr) ? nullptr : pool + (x - from)); };
+        for (auto i = 0; i < used; i++) {
+            if (move) {
+                pool[i].key = std::move(from[i].key);
+                pool[i].val = std::move(from[i].val);
+            } else {
+                pool[i].key = from[i].key;
+                pool[i].val = from[i].val;
+            }
+            pool[i].next = rebase(from[i].next);
+        }
+        head = rebase(head);
+        free_list = rebase(free_list);
+        return;
+    }
+
+    // moves the pool into a new array of the given capacity
+    void resize(const int new_capacity) {
+        auto* old_pool = pool;
+        pool = new Node[new_capacity];
+        copy_nodes(old_pool, true);
+        delete[] old_pool;
+        capacity = new_capacity;
         return;
     }
 
-    // removes the node with the a key from a list rooted at n
-    Node* remove(Node* x, const Key& key) {
-        if (x == nullptr) return (nullptr);
-        if (x->key == key) {
-            n--;
-            return (x->next);
+    // inserts a new key-value pair at the head of the linked list and returns its node
+    Node* insert(const Key& key, const Value& val) {
+        // take a removed node, or the next node of the pool
+        Node* it;
+        if (free_list != nullptr) {
+            it = free_list;
+            free_list = it->next;
+        } else {
+            if (used == capacity) resize((capacity == 0) ? initial_capacity : 2 * capacity);
+            it = pool + used++;
         }
-        x->next = remove(x->next, key);
-        return (x);
+        it->key = key;
+        it->val = val;
+        it->next = head;
+        head = it;
+        n++;
+        return (it);
+    }
+
+    // copys the pool of an existing table
+    void deep_copy(const SequentialSearchST& st) {
+        capacity = st.capacity;
+        used = st.used;
+        head = st.head;
+        free_list = st.free_list;
+        n = st.n;
+        policy = st.policy;
+        pool = nullptr;
+        if (capacity > 0) {
+            pool = new Node[capacity];
+            copy_nodes(st.pool, false);
+        }
+        return;
+    }
+
+    // frees the pool and empties the linked list
+    void free_pool() {
+        delete[] pool;
+        pool = head = free_list = nullptr;
+        capacity = used = n = 0;
+        return;
     }
 
    public:
-    // default constructor
-    SequentialSearchST() : head(nullptr), n(0) {}
+    // constructor with the self-organizing policy (none by default)
+    SequentialSearchST(const SelfOrganizing p = SelfOrganizing::none)
+        : pool(nullptr), capacity(0), used(0), head(nullptr), free_list(nullptr), n(0), policy(p) {}
 
     // copy constructor
-    SequentialSearchST(const SequentialSearchST& st) : n(st.n) { deep_copy_list(st.root); }
+    SequentialSearchST(const SequentialSearchST& st) { deep_copy(st); }
 
     // move constructor
-    SequentialSearchST(SequentialSearchST&& st) : head(st.head), n(st.n) {
-        st.root = nullptr;
-        st.n = 0;
+    SequentialSearchST(SequentialSearchST&& st)
+        : pool(st.pool), capacity(st.capacity), used(st.used), head(st.head), free_list(st.free_list), n(st.n),
+          policy(st.policy) {
+        st.pool = nullptr;
+        st.free_pool();
     }
 
     // copy assignment
     SequentialSearchST& operator=(const SequentialSearchST& st) {
-        // free the existing list
-        free_list();
-        // copy the list
-        deep_copy_list(st.head);
+        // free the existing pool
+        free_pool();
+        // copy the pool
+        deep_copy(st);
         return (*this);
     }
 
     // move assignment
     SequentialSearchST& operator=(SequentialSearchST&& st) {
-        // free the existing list
-        free_list();
+        // free the existing pool
+        free_pool();
 
+        pool = st.pool;
+        capacity = st.capacity;
+        used = st.used;
         head = st.head;
+        free_list = st.free_list;
         n = st.n;
-        st.root = nullptr;
-        st.n = 0;
+        policy = st.policy;
+        st.pool = nullptr;
+        st.free_pool();
         return (*this);
     }
 
     // destructor
-    ~SequentialSearchST() { free_list(); }
+    ~SequentialSearchST() { free_pool(); }
 
     // put a key-value pair into the table
     void put(const Key& key, const Value& val) {
-        for (auto* it = head; it != nullptr; it = it->next) {
-            if (it->key == key) {
-                it->val = val;
-                return;
-            }
+        auto* it = find(key);
+        if (it != nullptr) {
+            it->val = val;
+            return;
         }
 
-        head = new Node(key, val, head);
-        n++;
+        insert(key, val);
         return;
     }
 
-    // gets a value for a given key
+    // gets a value for a given key (the pointer is valid until the next put)
     const Value* get(const Key& key) const {
-        for (auto* it = head; it != nullptr; it = it->next) {
-            if (it->key == key)
-                return (&(it->val));
-        }
-        return (nullptr);
+        auto* it = find(key);
+        return ((it == nullptr) ? nullptr : &(it->val));
+    }
+
+    // gets the value for a given key to update in place, putting the key with val first if it is new
+    Value& get_or_insert(const Key& key, const Value& val) {
+        auto* it = find(key);
+        if (it == nullptr) it = insert(key, val);
+        return (it->val);
     }
 
     // removes a key from the table
-    void remove(const Key& key) { head = remove(head, key); }
+    void remove(const Key& key) {
+        Node* prev = nullptr;
+        for (auto* it = head; it != nullptr; prev = it, it = it->next) {
+            if (it->key == key) {
+                if (prev == nullptr)
+                    head = it->next;
+                else
+                    prev->next = it->next;
+
+                // release the contents and keep the node for reuse
+                it->key = Key();
+                it->val = Value();
+                it->next = free_list;
+                free_list = it;
+                n--;
+                return;
+            }
+        }
+        return;
+    }
 
     // checks if there is a value paired with a key
     bool contains(const Key& key) const { return (get(key) != nullptr); }
@@ -137,10 +253,10 @@ class SequentialSearchST : public ST<Key, Value> {
     // returns all keys in the symbol table
     Queue<Key> keys() const {
         Queue<Key> queue;
-        for (auto* it = head; it != nullptr; it = it->next) 
+        for (auto* it = head; it != nullptr; it = it->next)
             queue.enqueue(it->key);
         return (queue);
     }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -13,7 +13,7 @@
 
 // Implements the class for a symbol table based on (un-balanced) binary search trees
 template <typename Key, typename Value>
-class BST : public ST<Key, Value> {
+class BST {
     // a helper binary tree node data type
     struct Node {
         Key key;
@@ -61,6 +61,16 @@ class BST : public ST<Key, Value> {
         return &(n->val);
     }
 
+    // uses recursion to visit the key-value pairs of the tree in order of the keys
+    template <typename Visit>
+    void for_each(const Node* n, Visit& visit) const {
+        if (n == nullptr) return;
+        for_each(n->left, visit);
+        visit(n->key, n->val);
+        for_each(n->right, visit);
+        return;
+    }
+
     // uses recursion to put a key-value pair into the tree
     Node* put(Node* n, const Key& key, const Value& val) const {
         if (n == nullptr) {
@@ -79,6 +89,36 @@ class BST : public ST<Key, Value> {
         return (n);
     }
 
+    // finds the node of key (or NULL) with its value open to updates
+    Node* find(Node* n, const Key& key) const {
+        while (n != nullptr) {
+            if (key < n->key)
+                n = n->left;
+            else if (key > n->key)
+                n = n->right;
+            else
+                return (n);
+        }
+        return (nullptr);
+    }
+
+    // uses recursion to put a key-value pair into the tree as put does (except that a key in the tree keeps
+    // its value) and sets node to the node of the key
+    Node* put(Node* n, const Key& key, const Value& val, Node*& node) const {
+        if (n == nullptr) {
+            node = new Node(key, val, 1);
+            return (node);
+        }
+        if (key < n->key)
+            n->left = put(n->left, key, val, node);
+        else if (key > n->key)
+            n->right = put(n->right, key, val, node);
+        else
+            node = n;
+        n->size = size(n->left) + size(n->right) + 1;
+        return (n);
+    }
+
     // finds the minimum of a tree rooted at n
     Node* min(Node* n) const {
         if (n->left == nullptr)
@@ -167,6 +207,15 @@ class BST : public ST<Key, Value> {
     // gets a value for a given key
     const Value* get(const Key& key) const { return (get(root, key)); }
 
+    // gets the value for a given key to update in place, putting the key with val first if it is new (one
+    // search for a key in the tree, and the descent of put for a new key)
+    Value& get_or_insert(const Key& key, const Value& val) {
+        Node* node = find(root, key);
+        if (node != nullptr) return (node->val);
+        root = put(root, key, val, node);
+        return (node->val);
+    }
+
     // removes a key from the table
     void remove(const Key& key) { root = remove(root, key); }
 
@@ -178,6 +227,10 @@ class BST : public ST<Key, Value> {
 
     // number of nodes stored in the BST
     int size() const { return (size(root)); }
+
+    // calls visit(key, value) for all key-value pairs in order of the keys
+    template <typename Visit>
+    void for_each(Visit visit) const { for_each(root, visit); }
 };
 
 #endif
\ No newline at end of file
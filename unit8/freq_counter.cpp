@@ -37,83 +37,111 @@
  *  tr -s '[[:punct:][:space:]]' '\n' < ~/Downloads/leipzig100K.txt  0.85s user 0.01s system 99% cpu 0.861 total
  *  sort  2.03s user 0.06s system 5% cpu 36.591 total
  *  ./freq_counter_bst 10  36.62s user 0.13s system 95% cpu 38.370 total
+ *
+ *  The input is mapped into memory (or read at once from a pipe) and split into words in place, so the keys
+ *  of the symbol tables are views into the input; the file may also be given after the minimum length
+ *
+ *      ./freq_counter_redblack_bst 8 ../data/tale.txt
+ *
+ *  A number of threads after the file counts in parallel (parallel_counter.h) with 1, 2, 4, ... up to that
+ *  number of threads and reports the throughput of each
+ *
+ *      ./freq_counter_redblack_bst 8 ../data/tale.txt 4
+ *
+ *  threads        time        MB/s
+ *        1     ... ms         ...
+ *        2     ... ms         ...
+ *        4     ... ms         ...
+ *  business 122
+ *  distinct = 5131
+ *  words    = 14350
  ******************************************************************************/
 
+#include <chrono>
 #include <cstdlib>
 #include <iomanip>
 #include <iostream>
 #include <string>
+#include <string_view>
 
+#include "freq_counter.h"
+#include "parallel_counter.h"
 #include "st.h"
+#include "tokenizer.h"
+
+using namespace std;
 
 #ifdef BST_SEARCH
 #include "bst.h"
+using Table = BST<string_view, int>;
 #endif
 
 #ifdef REDBLACK_BST_SEARCH
 #include "redblack_bst.h"
+using Table = RedBlackBST<string_view, int>;
 #endif
 
-using namespace std;
+// performs the frequency counting test on the words of the text with direct calls to the table
+template <typename Table>
+void freq_counter(Table& st, const MappedFile& text, int min_len) {
+    auto result = freq_count(st, text.data(), text.size(), min_len);
 
-// a linked list to store the individual keys that we have encountered when parsing the input
-struct List {
-    string key;
-    List* next;
-    List(const string& k, List* n) : key(k), next(n) {}
-};
+    // finally, check that the tree is empty
+    if (result.remaining != 0) {
+        cerr << "Something went wrong in the put or delete (" << result.remaining << ")" << endl;
+    }
 
-// adds a keyword to the keyword list
-List* add_keyword(List* head, const string& k) {
-    return (new List(k, head));
-}
+    // output final statistics
+    cout << result.max_str << " " << result.max_cnt << endl;
+    cout << "distinct = " << result.distinct << endl;
+    cout << "words    = " << result.words << endl;
 
-// deletes the keyword list
-void delete_keywords(List* head) {
-    while (head) {
-        List* t = head->next;
-        delete head;
-        head = t;
-    }
     return;
 }
 
-// performs the frequency counting test
-void freq_counter(ST<string, int>* st, int min_len) {
-    int distinct = 0, words = 0;
-    string max_str = "";
+// performs the frequency counting test in parallel with 1, 2, 4, ... and max_threads threads, reporting the
+// throughput of every number of threads (the most frequent word is the same as for the sequential count)
+template <typename Table>
+void parallel_freq_counter(const MappedFile& text, int min_len, int max_threads) {
+    long long distinct = 0, words = 0;
+    string_view max_str = "";
     int max_cnt = 0;
 
-    // first parse all the input strings and put them both in the list and count them with the symbol table
-    string key;
-    List* keywords = nullptr;
-    while (cin >> key) {
-        if (key.length() < min_len) continue;
-
-        words++;
-        if (st->contains(key)) {
-            auto new_count = *(st->get(key)) + 1;
-            if (new_count > max_cnt) {
-                max_cnt = new_count;
-                max_str = key;
-            }
-            st->put(key, new_count);
-        } else {
-            keywords = add_keyword(keywords, key);
-            st->put(key, 1);
-            distinct++;
+    cout << setw(7) << "threads" << setw(12) << "time" << setw(12) << "MB/s" << endl;
+    for (auto threads = 1; threads <= max_threads; threads *= 2) {
+        // always finish with the maximum number of threads
+        if (threads > max_threads / 2) threads = max_threads;
+
+        auto last_str = max_str;
+        auto last_cnt = max_cnt;
+        auto last_distinct = distinct;
+        auto start = chrono::steady_clock::now();
+        Table* st =
+            parallel_count_words<Table>(text.data(), text.size(), min_len, threads, words, max_str, max_cnt);
+        auto stop = chrono::steady_clock::now();
+        auto ms = chrono::duration<double, milli>(stop - start).count();
+
+        // the number of distinct words
+        List* keywords = nullptr;
+        st->for_each([&](const string_view& key, const int) { keywords = add_keyword(keywords, key); });
+        distinct = st->size();
+
+        // remove all the keywords from the merged tree again and check that it is empty
+        for (List* t = keywords; t != nullptr; t = t->next) {
+            st->remove(t->key);
         }
-    }
-
-    // now iterate through all the keywords and remove them from the symbol table again
-    for (List* t = keywords; t != nullptr; t = t->next) {
-        st->remove(t->key);
-    }
-    delete_keywords(keywords);
+        delete_keywords(keywords);
+        if (!st->is_empty()) {
+            cerr << "Something went wrong in the put or delete (" << st->size() << ")" << endl;
+        }
+        delete st;
 
-    // finally, check that the tree is empty
-    if (!st->is_empty()) {
-        cerr << "Something went wrong in the put or delete (" << st->size() << ")" << endl;
+        cout << setw(7) << threads << fixed << setprecision(1) << setw(9) << ms << " ms" << setw(12)
+             << text.size() / ms / 1000;
+        if (threads > 1 && (max_str != last_str || max_cnt != last_cnt || distinct != last_distinct)) {
+            cout << " (counts differ!)";
+        }
+        cout << endl;
     }
 
     // output final statistics
@@ -126,20 +154,18 @@ void freq_counter(ST<string, int>* st, int min_len) {
 
 // main entry point of the program
 int main(int argc, char* argv[]) {
-    int min_len = (argc == 2) ? atoi(argv[1]) : 1;
-
-// compute frequency counts
-#ifdef BST_SEARCH
-    BST<string, int>* bst = new BST<string, int>();
-    freq_counter(bst, min_len);
-    delete bst;
-#endif
-
-#ifdef REDBLACK_BST_SEARCH
-    RedBlackBST<string, int>* red_black_bst = new RedBlackBST<string, int>();
-    freq_counter(red_black_bst, min_len);
-    delete red_black_bst;
-#endif
+    int min_len = (argc >= 2) ? atoi(argv[1]) : 1;
+    MappedFile text = (argc >= 3) ? MappedFile(string(argv[2])) : MappedFile(0);
+    int threads = (argc >= 4) ? atoi(argv[3]) : 0;
+
+    // compute frequency counts
+    if (threads > 0) {
+        parallel_freq_counter<Table>(text, min_len, threads);
+    } else {
+        Table* st = new Table();
+        freq_counter(*st, text, min_len);
+        delete st;
+    }
 
     return (0);
 }
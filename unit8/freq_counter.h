@@ -0,0 +1,85 @@
+/******************************************************************************
+ *
+ * The frequency counting test for symbol tables, templated over the symbol table class
+ *
+ ******************************************************************************/
+
+#ifndef __FREQ_COUNTER_H__
+#define __FREQ_COUNTER_H__
+
+#include <cstddef>
+#include <string_view>
+
+#include "st.h"
+#include "tokenizer.h"
+
+// a linked list to store the individual keys that we have encountered when parsing the input
+struct List {
+    std::string_view key;
+    List* next;
+    List(const std::string_view& k, List* n) : key(k), next(n) {}
+};
+
+// adds a keyword to the keyword list
+inline List* add_keyword(List* head, const std::string_view& k) {
+    return (new List(k, head));
+}
+
+// deletes the keyword list
+inline void delete_keywords(List* head) {
+    while (head) {
+        List* t = head->next;
+        delete head;
+        head = t;
+    }
+    return;
+}
+
+// the result of a frequency count
+struct FreqCount {
+    std::string_view max_str;  // the first word to reach the top count (of at least 2)
+    int max_cnt;               // number of occurrences of max_str
+    long long distinct;        // number of distinct words
+    long long words;           // number of words
+    int remaining;             // number of keys left in the table after removing all words (0 if correct)
+};
+
+// Counts the words of at least min_len characters of the text into the table with a single search per word
+// (the keys are views into the text) and then removes all words from the table again. The table may be of
+// any class with the member functions of ST (see is_symbol_table), whose calls are then resolved at compile
+// time; for ST itself they stay virtual calls
+template <typename Table>
+FreqCount freq_count(Table& st, const char* text, const size_t length, const int min_len) {
+    static_assert(is_symbol_table<Table, std::string_view, int>::value, "the table must map words to counts");
+    FreqCount result{"", 0, 0, 0, 0};
+
+    // first split the text into words and put the new ones in the list and count them with the symbol table
+    Tokenizer tokenizer(text, length);
+    std::string_view key;
+    List* keywords = nullptr;
+    while (tokenizer.next(key)) {
+        if ((int)key.length() < min_len) continue;
+
+        result.words++;
+        auto& count = st.get_or_insert(key, 0);
+        if (count == 0) {
+            keywords = add_keyword(keywords, key);
+            result.distinct++;
+        } else if (count + 1 > result.max_cnt) {
+            result.max_cnt = count + 1;
+            result.max_str = key;
+        }
+        count++;
+    }
+
+    // now iterate through all the keywords and remove them from the symbol table again
+    for (List* t = keywords; t != nullptr; t = t->next) {
+        st.remove(t->key);
+    }
+    delete_keywords(keywords);
+    result.remaining = st.size();
+
+    return (result);
+}
+
+#endif
@@ -0,0 +1,72 @@
+/******************************************************************************
+ *
+ * A test application for the frequency count: the most frequent word of texts with tied counts has to be the
+ * same for the sequential count (freq_counter.h) and the parallel count (parallel_counter.h) with any number
+ * of threads, for both search trees
+ *
+ *      ./freq_counter_test
+ *
+ *  b b a a                                          bst b 2 ok    redblack b 2 ok
+ *  a b b a                                          bst b 2 ok    redblack b 2 ok
+ *  ...
+ ******************************************************************************/
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "bst.h"
+#include "freq_counter.h"
+#include "parallel_counter.h"
+#include "redblack_bst.h"
+
+using namespace std;
+
+// counts the words of the text sequentially and in parallel with 1 to 4 threads, prints the most frequent
+// word and its count and returns if all counts agree with the expected ones
+template <typename Table>
+bool test_ties(const string& name, const string& text, const string_view expected_str, const int expected_cnt) {
+    Table st;
+    auto result = freq_count(st, text.data(), text.size(), 1);
+    bool ok = (result.max_str == expected_str && result.max_cnt == expected_cnt);
+
+    for (auto threads = 1; threads <= 4; threads++) {
+        long long words = 0;
+        string_view max_str = "";
+        int max_cnt = 0;
+        Table* merged =
+            parallel_count_words<Table>(text.data(), text.size(), 1, threads, words, max_str, max_cnt);
+        ok = ok && max_str == expected_str && max_cnt == expected_cnt && words == result.words;
+        delete merged;
+    }
+
+    cout << setw(12) << name << " " << result.max_str << " " << result.max_cnt << (ok ? " ok" : " FAILED");
+    return (ok);
+}
+
+int main(void) {
+    // texts with their most frequent word (of equal counts the first word to reach the count)
+    struct {
+        string text;
+        string max_str;
+        int max_cnt;
+    } tests[]{{"b b a a", "b", 2},
+              {"a b b a", "b", 2},
+              {"c c b b a a", "c", 2},
+              {"a b c a b c", "a", 2},
+              {"a a b b b a", "b", 3},
+              {"x y z x y z w w w", "w", 3},
+              {"dog cat dog cat bird bird bird cat dog", "bird", 3},
+              {"one two three", "", 0}};
+
+    bool ok = true;
+    for (const auto& test : tests) {
+        cout << setw(40) << left << test.text << right;
+        ok = test_ties<BST<string_view, int>>("bst", test.text, test.max_str, test.max_cnt) && ok;
+        ok = test_ties<RedBlackBST<string_view, int>>("redblack", test.text, test.max_str, test.max_cnt) && ok;
+        cout << endl;
+    }
+
+    return (ok ? 0 : 1);
+}
@@ -0,0 +1,186 @@
+#ifndef __TOKENIZER_H__
+#define __TOKENIZER_H__
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Implements a read-only view of the whole contents of a file: a regular file is mapped into memory, any
+// other input (such as a pipe) is read into a buffer, so that the tokens can point into the contents
+class MappedFile {
+    char* contents;  // the contents of the file
+    size_t length;   // number of bytes of the contents
+    bool mapped;     // whether the contents are mapped (or read into a buffer)
+
+    // maps or reads the file behind a file descriptor
+    void load(const int fd) {
+        struct stat info;
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            length = info.st_size;
+            void* p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                madvise(p, length, MADV_SEQUENTIAL);
+                contents = (char*)p;
+                mapped = true;
+                return;
+            }
+        }
+
+        // read the input into a buffer that doubles as needed
+        size_t capacity = 1 << 16;
+        contents = new char[capacity];
+        length = 0;
+        mapped = false;
+        for (;;) {
+            if (length == capacity) {
+                auto bigger = new char[2 * capacity];
+                std::copy(contents, contents + length, bigger);
+                delete[] contents;
+                contents = bigger;
+                capacity *= 2;
+            }
+            auto count = read(fd, contents + length, capacity - length);
+            if (count < 0) {
+                delete[] contents;
+                throw std::runtime_error("Cannot read the input");
+            }
+            if (count == 0) break;
+            length += count;
+        }
+        return;
+    }
+
+   public:
+    // constructor for an open file descriptor (such as 0 for the standard input)
+    explicit MappedFile(const int fd) { load(fd); }
+
+    // constructor for the file with the given name
+    explicit MappedFile(const std::string& name) {
+        int fd = open(name.c_str(), O_RDONLY);
+        if (fd == -1) throw std::runtime_error("Cannot open " + name);
+        try {
+            load(fd);
+        } catch (...) {
+            close(fd);
+            throw;
+        }
+        close(fd);
+    }
+
+    // the contents are not copied
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // destructor
+    ~MappedFile() {
+        if (mapped)
+            munmap(contents, length);
+        else
+            delete[] contents;
+    }
+
+    // the contents of the file
+    const char* data() const { return (contents); }
+
+    // number of bytes of the file
+    size_t size() const { return (length); }
+};
+
+// checks if a character is white space (as for std::isspace in the C locale)
+inline bool is_space(const char c) {
+    return (c == ' ' || (unsigned char)(c - '\t') <= '\r' - '\t');
+}
+
+// returns the mask of the white space among the 64 bytes from p (bit i for p[i]); the bytes from end on
+// count as white space
+inline uint64_t space_mask(const char* p, const char* end) {
+#ifdef __AVX2__
+    if (end - p >= 64) {
+        // c is white space if c == ' ' or c - '\t' <= '\r' - '\t' (unsigned)
+        const __m256i blank = _mm256_set1_epi8(' ');
+        const __m256i tab = _mm256_set1_epi8('\t');
+        const __m256i range = _mm256_set1_epi8('\r' - '\t');
+        auto mask = [&](const __m256i c) {
+            const __m256i offset = _mm256_sub_epi8(c, tab);
+            const __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, range), offset);
+            return ((uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(c, blank), control)));
+        };
+        const uint64_t lo = mask(_mm256_loadu_si256((const __m256i*)p));
+        const uint64_t hi = mask(_mm256_loadu_si256((const __m256i*)(p + 32)));
+        return (lo | (hi << 32));
+    }
+#endif
+    uint64_t mask = 0;
+    for (auto i = 0; i < 64; i++) {
+        if (i >= end - p || is_space(p[i])) mask |= (uint64_t)1 << i;
+    }
+    return (mask);
+}
+
+// Implements a tokenizer that splits text into the words between white space (as std::cin >> word) without
+// copying them: the words are views into the text. The text is scanned in blocks of 64 bytes, whose white
+// space is found at once (with AVX2 if the compiler targets it) and kept as a bit mask, so that finding the
+// start and the end of a word takes a count of trailing zeros instead of a test per character
+class Tokenizer {
+    const char* text;  // the text
+    size_t length;     // number of bytes of the text
+    size_t block;      // offset of the current block
+    uint64_t space;    // white space mask of the current block
+    int pos;           // position of the scan in the current block
+
+    // moves to the next block and returns false at the end of the text
+    bool next_block() {
+        block += 64;
+        if (block >= length) return (false);
+        space = space_mask(text + block, text + length);
+        pos = 0;
+        return (true);
+    }
+
+   public:
+    // constructor for the text of the given length
+    Tokenizer(const char* t, const size_t len) : text(t), length(len), block(0), space(~(uint64_t)0), pos(0) {
+        if (length > 0) space = space_mask(text, text + length);
+    }
+
+    // finds the next word and returns false at the end of the text
+    bool next(std::string_view& word) {
+        // find the first character of the word
+        uint64_t chars = ~space & (~(uint64_t)0 << pos);
+        while (chars == 0) {
+            if (!next_block()) return (false);
+            chars = ~space;
+        }
+        const size_t start = block + __builtin_ctzll(chars);
+
+        // find the first white space after the word (the bytes after the text are white space)
+        uint64_t spaces = space & (~(uint64_t)0 << (start - block));
+        while (spaces == 0) {
+            if (!next_block()) {
+                word = std::string_view(text + start, length - start);
+                block = length;
+                space = ~(uint64_t)0;
+                pos = 0;
+                return (true);
+            }
+            spaces = space;
+        }
+        pos = __builtin_ctzll(spaces);
+        word = std::string_view(text + start, block + pos - start);
+        return (true);
+    }
+};
+
+#endif